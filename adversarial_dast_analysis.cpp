@@ -1,5 +1,6 @@
 #include "bits/stdc++.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -35,6 +36,10 @@ struct DepthAwareSplayTree {
     int total_depth = 0;
     int splay_count = 0;
 
+    // When positive, deep accesses only splay until the node's depth drops
+    // below this fraction of the threshold
+    double partial_fraction = 0;
+
     Node *root = nullptr;
 
     // Set a new root for the tree
@@ -69,6 +74,20 @@ struct DepthAwareSplayTree {
         }
     }
 
+    // Splay a node at the given depth (root = 1) until its depth drops
+    // below the partial splay target
+    void partial_splay(Node *x, int depth) {
+        int target_depth = max(1, int(partial_fraction * threshold));
+        while (x != root && depth >= target_depth) {
+            if (x->parent != root) {
+                rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
+                depth--;
+            }
+            rotate_up(x);
+            depth--;
+        }
+    }
+
     // Insert a key into the tree
     void insert(int key) {
         size++;
@@ -101,7 +120,7 @@ struct DepthAwareSplayTree {
     Node *lower_bound(const int &key) {
         Node *current = root;
         Node *answer = nullptr;
-        int depth = 0;
+        int depth = 0, answer_depth = 0;
 
         while (current != nullptr) {
             depth++;
@@ -110,13 +129,17 @@ struct DepthAwareSplayTree {
                 current = current->child[1];
             } else {
                 answer = current;
+                answer_depth = depth;
                 current = current->child[0];
             }
         }
         total_depth += depth;
         if (answer && depth >= threshold) {
             splay_count++;
-            splay(answer);
+            if (partial_fraction > 0)
+                partial_splay(answer, answer_depth);
+            else
+                splay(answer);
         }
         return answer;
     }
@@ -162,26 +185,25 @@ struct DepthAwareSplayTree {
     }
 };
 
-int main() {
-    int testSize = 10000;
-    int cycles = 10;
-    int numAccess = testSize * cycles;
-    auto testData = test::generateGradualAccessTest(testSize, cycles);
-
+// Sweep the depth threshold, replaying the whole test for each value
+int runThresholdSweep(const test::TestType& testData, int numAccess, double partialFraction, const string& outputFileName) {
     // Open the CSV file for writing
-    std::ofstream outFile("output/dast_analysis/adversarial_dast_data.csv");
+    std::ofstream outFile(outputFileName);
     if (!outFile.is_open()) {
         std::cerr << "Error: Could not open file for writing!" << std::endl;
         return 1;
     }
 
     // Write the CSV headers
-    outFile << "depth_threshold,avg_query_time(microseconds),avg_depth,splay_count\n";
+    outFile << "depth_threshold,avg_query_time(microseconds),avg_depth,splay_count,"
+            << "query_time(p50),query_time(p99),query_time(p99.9),query_time(max)\n";
 
     for (int threshold = 0; threshold < 300; threshold++) {
         DepthAwareSplayTree tree;
         tree.threshold = threshold;
+        tree.partial_fraction = partialFraction;
         double total_query_time = 0.0;
+        latency::Histogram queryLatency;
 
         for (auto q : testData) {
             if (q.first == 0) {
@@ -192,6 +214,7 @@ int main() {
                 auto end = std::chrono::high_resolution_clock::now();
                 double queryTime = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
                 total_query_time += queryTime;
+                queryLatency.record(end - start);
             }
         }
 
@@ -207,7 +230,10 @@ int main() {
         outFile << threshold << ","
                 << std::fixed << std::setprecision(6) << total_query_time << ","
                 << std::fixed << std::setprecision(6) << avg_depth << ","
-                << tree.splay_count << "\n";
+                << tree.splay_count;
+        for (double value : queryLatency.summary())
+            outFile << "," << value;
+        outFile << "\n";
 
         cerr << threshold << ","
                 << std::fixed << std::setprecision(6) << total_query_time << ","
@@ -218,7 +244,20 @@ int main() {
     // Close the file
     outFile.close();
 
-    std::cout << "Data written to output/dast_analysis/dast_data.csv" << std::endl;
+    std::cout << "Data written to " << outputFileName << std::endl;
 
     return 0;
 }
+
+int main() {
+    int testSize = 10000;
+    int cycles = 10;
+    int numAccess = testSize * cycles;
+    auto testData = test::generateGradualAccessTest(testSize, cycles);
+
+    // Full splay to the root, then partial splay to half the threshold
+    if (runThresholdSweep(testData, numAccess, 0, "output/dast_analysis/adversarial_dast_data.csv"))
+        return 1;
+
+    return runThresholdSweep(testData, numAccess, 0.5, "output/dast_analysis/adversarial_partial_dast_data.csv");
+}
@@ -0,0 +1,148 @@
+#include "bits/stdc++.h"
+#include "internal/test_gen.h"
+#include "internal/baseline_zoo.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Structures in the order of the result columns
+const vector<string> treeNames = {"RedBlackTree", "OriginalSplayTree", "DepthAwareSplayTree", "BucketDAST", "BTree",
+                                  "Treap", "AVLTree", "SkipList", "SortedVector"};
+
+// Build the structure from the inserts of testData, then time each lookup.
+// Appends the average lookup time (microseconds) and the latency histogram.
+template <typename Tree>
+void measure(const test::TestType& testData, vector<double>& averages, vector<latency::Histogram>& histograms) {
+    auto tree = make_unique<Tree>();
+    for (const auto& q : testData) {
+        if (q.first == 0) {
+            tree->insert(q.second);
+        }
+    }
+
+    double total = 0;
+    long long lookups = 0;
+    latency::Histogram histogram;
+    [[maybe_unused]] const int* volatile sink = nullptr;  // Keeps side-effect free lookups from being optimized out
+
+    // One untimed lookup, so that the deferred sort of SortedVector is
+    // charged to the build rather than to the first measured lookup
+    sink = tree->lower_bound(0);
+
+    for (const auto& q : testData) {
+        if (q.first == 1) {
+            auto start = high_resolution_clock::now();
+            sink = tree->lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            total += duration_cast<duration<double>>(end - start).count();
+            histogram.record(end - start);
+            lookups++;
+        }
+    }
+
+    averages.push_back(lookups ? total / lookups * 1e6 : 0);
+    histograms.push_back(histogram);
+}
+
+// Run one workload against every structure in the zoo, timed identically
+template <typename... Trees>
+void measureAll(const test::TestType& testData, vector<double>& averages, vector<latency::Histogram>& histograms) {
+    (measure<Trees>(testData, averages, histograms), ...);
+}
+
+void measureZoo(const test::TestType& testData, vector<double>& averages, vector<latency::Histogram>& histograms) {
+    measureAll<zoo::RedBlackTree, zoo::SplayTree, zoo::DepthAwareSplayTree, zoo::BucketDAST, zoo::BTree,
+               zoo::Treap, zoo::AVLTree, zoo::SkipList, zoo::SortedVector>(testData, averages, histograms);
+}
+
+// Run a sweep of one workload and write its average and latency CSVs
+void runWorkload(const string& name, const string& parameter, const vector<int>& parameters,
+                 const function<test::TestType(int)>& generate) {
+    vector<vector<double>> results, latencies;
+
+    vector<string> columns = {parameter};
+    columns.insert(columns.end(), treeNames.begin(), treeNames.end());
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {parameter};
+    for (const auto& treeName : treeNames) {
+        auto names = latency::Histogram::summary_columns(treeName);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int value : parameters) {
+        cout << "Workload " << name << ", " << parameter << ": " << value << endl;
+        auto testData = generate(value);
+
+        vector<double> averages;
+        vector<latency::Histogram> histograms;
+        measureZoo(testData, averages, histograms);
+
+        vector<double> row = {(double)value}, latencyRow = {(double)value};
+        for (size_t i = 0; i < treeNames.size(); i++) {
+            cout << "  " << treeNames[i] << ": " << averages[i] << "us, p99.9 "
+                 << histograms[i].percentile(99.9) / 1e3 << "us" << endl;
+            row.push_back(averages[i]);
+            auto summary = histograms[i].summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        results.push_back(row);
+        latencies.push_back(latencyRow);
+    }
+
+    writeCSV(results, columns, "output/baseline_benchmark/" + name + ".csv");
+    writeCSV(latencies, latencyColumns, "output/baseline_benchmark/" + name + "_latency.csv");
+}
+
+int main() {
+    // Uniform random lookups, as in random_benchmark.cpp
+    int numAccess = 1000000;
+    runWorkload("random", "TreeSize", {1000, 100000, 1000000},
+                [&](int testSize) { return test::generateTestData(testSize, numAccess); });
+
+    // Skewed lookups into a hot pool, as in cache_benchmark.cpp
+    int testSize = 1000000;
+    runWorkload("cache", "CachePoolSize", {10, 1000, 100000},
+                [&](int cachePoolSize) { return test::generateCacheAccessTest(testSize, cachePoolSize, testSize); });
+
+    // Repeated sequential scans, as in worst_case_experiment.cpp
+    int cycle = 5;
+    runWorkload("worst_case", "TreeSize", {1000000},
+                [&](int size) { return test::generateGradualAccessTest(size, cycle); });
+
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include "internal/original_splay_tree.h"
 #include "internal/depth_aware_splay_tree.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -39,8 +40,9 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
-    dast::DepthAwareSplayTree dastTree;
+int main(int argc, char* argv[]) {
+    dast::DepthAwareSplayTree dastTree, partialTree;
+    partialTree.partial_splay_fraction = 0.5;
     ost::SplayTree tree;
     set<int> stdSet;
 
@@ -49,10 +51,18 @@ int main() {
     vector<int> cachePoolSizes = {10, 100, 1000, 10000, 100000, 1000000};
 
     // Result storage
-    vector<vector<double>> results;
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
 
     // Column headers
-    vector<string> columns = {"CachePoolSize", "std::set", "OriginalSplayTree", "DepthAwareSplayTree"};
+    vector<string> columns = {"CachePoolSize", "std::set", "OriginalSplayTree", "DepthAwareSplayTree", "PartialSplayDAST"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"CachePoolSize"};
+    for (const char* name : {"std::set", "OriginalSplayTree", "DepthAwareSplayTree", "PartialSplayDAST"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
 
     for (int cachePoolSize : cachePoolSizes) {
         cout << "Testing cache pool size: " << cachePoolSize << endl;
@@ -62,6 +72,7 @@ int main() {
 
         // Clear previous tree data
         dastTree.clear();
+        partialTree.clear();
         tree.clear();
         stdSet.clear();
 
@@ -69,13 +80,15 @@ int main() {
         for (const auto& q : testData) {
             if (q.first == 0) {
                 dastTree.insert(q.second);
+                partialTree.insert(q.second);
                 tree.insert(q.second);
                 stdSet.insert(q.second);
             }
         }
 
         // Measure time for each tree
-        double stdSetResult = 0, treeResult = 0, dastResult = 0;
+        double stdSetResult = 0, treeResult = 0, dastResult = 0, partialResult = 0;
+        latency::Histogram stdSetLatency, treeLatency, dastLatency, partialLatency;
 
         for (const auto& q : testData) {
             if (q.first == 1) {
@@ -84,18 +97,28 @@ int main() {
                 stdSet.find(q.second);
                 auto end = high_resolution_clock::now();
                 stdSetResult += duration_cast<duration<double>>(end - start).count();
+                stdSetLatency.record(end - start);
 
                 // Measure Original Splay Tree
                 start = high_resolution_clock::now();
                 tree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 treeResult += duration_cast<duration<double>>(end - start).count();
+                treeLatency.record(end - start);
 
                 // Measure Depth-Aware Splay Tree
                 start = high_resolution_clock::now();
                 dastTree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 dastResult += duration_cast<duration<double>>(end - start).count();
+                dastLatency.record(end - start);
+
+                // Measure Depth-Aware Splay Tree with partial splaying
+                start = high_resolution_clock::now();
+                partialTree.lower_bound(q.second);
+                end = high_resolution_clock::now();
+                partialResult += duration_cast<duration<double>>(end - start).count();
+                partialLatency.record(end - start);
             }
         }
 
@@ -103,19 +126,33 @@ int main() {
         double avgStdSetTime = (stdSetResult / testData.size()) * 1e6;
         double avgTreeTime = (treeResult / testData.size()) * 1e6;
         double avgDastTime = (dastResult / testData.size()) * 1e6;
+        double avgPartialTime = (partialResult / testData.size()) * 1e6;
 
         // Print results for the current cache pool size
         cout << "Cache Pool Size: " << cachePoolSize
              << ", std::set: " << avgStdSetTime << "us"
              << ", Original Splay Tree: " << avgTreeTime << "us"
-             << ", Depth-Aware Splay Tree: " << avgDastTime << "us" << endl;
+             << ", Depth-Aware Splay Tree: " << avgDastTime << "us"
+             << ", Partial Splay DAST: " << avgPartialTime << "us" << endl;
+
+        // Flag tail regressions of the depth-aware tree
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "OriginalSplayTree", treeLatency);
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "std::set", stdSetLatency);
 
         // Store results for CSV
-        results.push_back({(double)cachePoolSize, avgStdSetTime, avgTreeTime, avgDastTime});
+        results.push_back({(double)cachePoolSize, avgStdSetTime, avgTreeTime, avgDastTime, avgPartialTime});
+
+        vector<double> latencyRow = {(double)cachePoolSize};
+        for (const auto* histogram : {&stdSetLatency, &treeLatency, &dastLatency, &partialLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
     }
 
     // Write results to CSV
     writeCSV(results, columns, "output/cache_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/cache_benchmark/latency.csv");
 
-    return 0;
+    return latency::compare_mode(argc, argv) && regressed;
 }
@@ -0,0 +1,138 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Average lookup time in microseconds over all find operations; each
+// lookup is also recorded in histogram
+double measureLookups(dast::DepthAwareSplayTree& dastTree, const test::TestType& testData, latency::Histogram& histogram) {
+    double total = 0;
+    int count = 0;
+
+    for (const auto& q : testData) {
+        if (q.first == 1) {
+            auto start = high_resolution_clock::now();
+            dastTree.lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            total += duration_cast<duration<double>>(end - start).count();
+            histogram.record(end - start);
+            count++;
+        }
+    }
+
+    return total / count * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    dast::DepthAwareSplayTree dastTree;
+
+    // Test parameters
+    int numAccess = 1000000;
+    vector<int> testSizes;
+    for (int i = 1 << 20; i <= (1 << 24); i *= 2)
+        testSizes.push_back(i);
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "BeforeCompact", "AfterCompact", "CompactTime(ms)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"BeforeCompact", "AfterCompact"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        // Generate test data
+        auto testData = test::generateTestData(testSize, numAccess);
+
+        // Clear previous tree data
+        dastTree.clear();
+
+        // Insert phase, followed by a round of lookups to scatter the layout
+        for (const auto& q : testData) {
+            if (q.first == 0) {
+                dastTree.insert(q.second);
+            } else {
+                dastTree.lower_bound(q.second);
+            }
+        }
+
+        latency::Histogram beforeLatency, afterLatency;
+        double beforeTime = measureLookups(dastTree, testData, beforeLatency);
+
+        auto start = high_resolution_clock::now();
+        dastTree.compact();
+        auto end = high_resolution_clock::now();
+        double compactTime = duration_cast<duration<double>>(end - start).count() * 1e3;
+
+        double afterTime = measureLookups(dastTree, testData, afterLatency);
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize
+             << ", Before compact: " << beforeTime << "us"
+             << ", After compact: " << afterTime << "us"
+             << ", Compact: " << compactTime << "ms" << endl;
+
+        // Flag a tail regression caused by the relayout
+        regressed |= latency::compare_tail("AfterCompact", afterLatency, "BeforeCompact", beforeLatency);
+
+        // Store results for CSV
+        results.push_back({(double)testSize, beforeTime, afterTime, compactTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&beforeLatency, &afterLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/compact_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/compact_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
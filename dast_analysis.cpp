@@ -1,5 +1,6 @@
 #include "bits/stdc++.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -171,12 +172,14 @@ int main() {
         }
 
         // Write the CSV headers
-        outFile << "depth_threshold,avg_query_time(microseconds),avg_depth,splay_count\n";
+        outFile << "depth_threshold,avg_query_time(microseconds),avg_depth,splay_count,"
+                << "query_time(p50),query_time(p99),query_time(p99.9),query_time(max)\n";
 
         for (int threshold = 0; threshold < 120; threshold++) {
             DepthAwareSplayTree tree;
             tree.threshold = threshold;
             double total_query_time = 0.0;
+            latency::Histogram queryLatency;
 
             for (auto q : testData) {
                 if (q.first == 0) {
@@ -188,6 +191,7 @@ int main() {
 
                     double queryTime = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
                     total_query_time += queryTime;
+                    queryLatency.record(end - start);
                 }
             }
 
@@ -200,7 +204,10 @@ int main() {
             outFile << threshold << ","
                     << std::fixed << std::setprecision(6) << total_query_time << ","
                     << std::fixed << std::setprecision(6) << avg_depth << ","
-                    << tree.splay_count << "\n";
+                    << tree.splay_count;
+            for (double value : queryLatency.summary())
+                outFile << "," << value;
+            outFile << "\n";
 
             cerr << threshold << ","
                  << std::fixed << std::setprecision(6) << total_query_time << ","
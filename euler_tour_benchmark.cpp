@@ -0,0 +1,188 @@
+#include "bits/stdc++.h"
+#include "internal/euler_tour_dast.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// One operation of a dynamic forest stream. Cuts and subtree queries pick
+// an existing edge by index at run time, since which links succeed
+// depends on the forest.
+struct Operation {
+    enum Type { Link, Cut, Connected, SubtreeSize, SubtreeSum } type;
+    int u, v;
+};
+
+// Random stream mixing updates and queries
+vector<Operation> generateRandomStream(int numNodes, int numOperations) {
+    vector<Operation> stream;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    uniform_int_distribution<> node(0, numNodes - 1), kind(0, 9);
+
+    for (int i = 0; i < numOperations; i++) {
+        int k = kind(gen);
+        Operation::Type type = k < 3 ? Operation::Link : k < 5 ? Operation::Cut : k < 8 ? Operation::Connected
+                             : k < 9 ? Operation::SubtreeSize : Operation::SubtreeSum;
+        stream.push_back({type, node(gen), node(gen)});
+    }
+    return stream;
+}
+
+// A random spanning tree (each vertex links to an earlier one), followed
+// by queries only
+vector<Operation> generateQueryStream(int numNodes, int numOperations) {
+    vector<Operation> stream;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    uniform_int_distribution<> node(0, numNodes - 1), kind(0, 2);
+
+    for (int i = 1; i < numNodes; i++) stream.push_back({Operation::Link, i, int(gen() % i)});
+    for (int i = 0; i < numOperations; i++) {
+        int k = kind(gen);
+        Operation::Type type = k == 0 ? Operation::Connected : k == 1 ? Operation::SubtreeSize : Operation::SubtreeSum;
+        stream.push_back({type, node(gen), node(gen)});
+    }
+    return stream;
+}
+
+// Run a stream and return the elapsed milliseconds; checksum folds in
+// every answer so that the two trees can be checked against each other.
+// Each operation is also recorded in histogram.
+template <typename Tree>
+double runStream(int numNodes, const vector<Operation>& stream, long long& checksum, latency::Histogram& histogram) {
+    Tree tree(numNodes);
+    for (int v = 0; v < numNodes; v++) tree.set_value(v, v % 1000);
+
+    vector<pair<int, int>> edges;
+    checksum = 0;
+
+    double total = 0;
+    for (const auto& op : stream) {
+        auto start = high_resolution_clock::now();
+        switch (op.type) {
+        case Operation::Link:
+            if (tree.link(op.u, op.v)) edges.push_back({op.u, op.v});
+            break;
+        case Operation::Cut:
+            if (!edges.empty()) {
+                int index = op.u % edges.size();
+                tree.cut(edges[index].first, edges[index].second);
+                edges[index] = edges.back();
+                edges.pop_back();
+            }
+            break;
+        case Operation::Connected:
+            checksum = checksum * 31 + tree.connected(op.u, op.v);
+            break;
+        case Operation::SubtreeSize:
+            if (!edges.empty()) {
+                auto [v, parent] = edges[op.u % edges.size()];
+                checksum = checksum * 31 + tree.subtree_size(v, parent);
+            }
+            break;
+        case Operation::SubtreeSum:
+            if (!edges.empty()) {
+                auto [v, parent] = edges[op.u % edges.size()];
+                checksum = checksum * 31 + tree.subtree_sum(v, parent);
+            }
+            break;
+        }
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(end - start);
+    }
+    return total * 1e3;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numOperations = 1000000;
+    vector<int> testSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"Nodes", "ClassicEulerTour(random)", "DepthAwareEulerTour(random)",
+                              "ClassicEulerTour(queries)", "DepthAwareEulerTour(queries)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"Nodes"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing forest size: " << testSize << endl;
+
+        vector<double> row = {(double)testSize};
+        vector<double> latencyRow = {(double)testSize};
+        int kind = 0;
+        for (const auto& stream : {generateRandomStream(testSize, numOperations), generateQueryStream(testSize, numOperations)}) {
+            long long classicChecksum, depthAwareChecksum;
+            latency::Histogram classicLatency, depthAwareLatency;
+            double classicTime = runStream<euler_tour::ClassicEulerTourTree>(testSize, stream, classicChecksum, classicLatency);
+            double depthAwareTime = runStream<euler_tour::EulerTourTree>(testSize, stream, depthAwareChecksum, depthAwareLatency);
+
+            if (classicChecksum != depthAwareChecksum) {
+                cerr << "Error: Euler-tour trees disagree on size " << testSize << endl;
+                return 1;
+            }
+
+            cout << "Classic: " << classicTime << "ms, Depth-Aware: " << depthAwareTime << "ms" << endl;
+            row.insert(row.end(), {classicTime, depthAwareTime});
+
+            // Flag a tail regression against the classic tree
+            regressed |= latency::compare_tail(columns[2 * kind + 2], depthAwareLatency, columns[2 * kind + 1], classicLatency);
+            for (const auto* histogram : {&classicLatency, &depthAwareLatency}) {
+                auto summary = histogram->summary();
+                latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+            }
+            kind++;
+        }
+
+        // Store results for CSV
+        results.push_back(row);
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/euler_tour_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/euler_tour_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
@@ -0,0 +1,200 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/flat_combining_dast.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Keys are in [0, 2^30)
+const int KEY_BITS = 30;
+
+// One lock around one tree
+struct MutexTree {
+    mutex lock;
+    dast::DepthAwareSplayTree tree;
+
+    void insert(int, int key) {
+        lock_guard<mutex> guard(lock);
+        tree.insert(key);
+    }
+
+    bool lower_bound(int, int key, int& result) {
+        lock_guard<mutex> guard(lock);
+        dast::Node* x = tree.lower_bound(key);
+        if (x) result = x->key;
+        return x != nullptr;
+    }
+
+    bool remove(int, int key) {
+        lock_guard<mutex> guard(lock);
+        dast::Node* x = tree.lower_bound(key);
+        if (x == nullptr || x->key != key) return false;
+        tree.remove(x);
+        return true;
+    }
+};
+
+// Key-range shards, each a tree behind its own lock; lower_bound moves on
+// to the next shards when a shard has no key >= the query
+struct ShardedTree {
+    static const int SHARD_BITS = 4;
+    MutexTree shards[1 << SHARD_BITS];
+
+    static int shardOf(int key) {
+        return key >> (KEY_BITS - SHARD_BITS);
+    }
+
+    void insert(int slot, int key) {
+        shards[shardOf(key)].insert(slot, key);
+    }
+
+    bool lower_bound(int slot, int key, int& result) {
+        for (int s = shardOf(key); s < (1 << SHARD_BITS); s++) {
+            if (shards[s].lower_bound(slot, key, result)) return true;
+        }
+        return false;
+    }
+
+    bool remove(int slot, int key) {
+        return shards[shardOf(key)].remove(slot, key);
+    }
+};
+
+// Run the mixed workload (80% lower_bound, 10% insert, 10% remove) on the
+// given number of threads for a fixed time; returns millions of ops per second.
+// Every 16th operation of each thread is timed into histogram, which keeps
+// the clock reads from eating into the measured throughput.
+template <typename Tree>
+double runThreads(Tree& tree, int numThreads, double seconds, latency::Histogram& histogram) {
+    atomic<bool> stop{false};
+    atomic<long long> totalOps{0};
+    vector<thread> threads;
+    vector<latency::Histogram> threadLatency(numThreads);
+
+    auto start = high_resolution_clock::now();
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&, t] {
+            mt19937 gen(t + 1);  // Fixed seed per thread for reproducibility
+            long long ops = 0;
+            int result;
+            while (!stop.load(memory_order_relaxed)) {
+                int key = gen() >> (32 - KEY_BITS);
+                int op = gen() % 10;
+                bool sampled = ops % 16 == 0;
+                auto opStart = sampled ? high_resolution_clock::now() : high_resolution_clock::time_point();
+                if (op == 0) tree.insert(t, key);
+                else if (op == 1) tree.remove(t, key);
+                else tree.lower_bound(t, key, result);
+                if (sampled) threadLatency[t].record(high_resolution_clock::now() - opStart);
+                ops++;
+            }
+            totalOps += ops;
+        });
+    }
+
+    this_thread::sleep_for(duration<double>(seconds));
+    stop = true;
+    for (auto& thread : threads) thread.join();
+    auto end = high_resolution_clock::now();
+    for (const auto& part : threadLatency) histogram.merge(part);
+
+    return totalOps / duration_cast<duration<double>>(end - start).count() / 1e6;
+}
+
+template <typename Tree>
+double runTree(int initialSize, int numThreads, double seconds, latency::Histogram& histogram) {
+    auto tree = make_unique<Tree>();
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    for (int i = 0; i < initialSize; i++) tree->insert(0, gen() >> (32 - KEY_BITS));
+    return runThreads(*tree, numThreads, seconds, histogram);
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int initialSize = 1000000;
+    double seconds = 1;
+    vector<int> threadCounts = {1, 2, 4, 8, 16, 32, 64};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers (millions of operations per second)
+    vector<string> columns = {"Threads", "MutexDAST", "ShardedDAST", "FlatCombiningDAST"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"Threads"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int numThreads : threadCounts) {
+        cout << "Testing threads: " << numThreads << endl;
+
+        latency::Histogram mutexLatency, shardedLatency, combiningLatency;
+        vector<double> row = {(double)numThreads};
+        row.push_back(runTree<MutexTree>(initialSize, numThreads, seconds, mutexLatency));
+        row.push_back(runTree<ShardedTree>(initialSize, numThreads, seconds, shardedLatency));
+        row.push_back(runTree<flat_combining::DepthAwareSplayTree>(initialSize, numThreads, seconds, combiningLatency));
+
+        // Print results for the current thread count
+        cout << "Threads: " << numThreads;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i] << " Mops/s";
+        cout << endl;
+
+        // Flag a tail regression of flat combining against the global lock
+        regressed |= latency::compare_tail("FlatCombiningDAST", combiningLatency, "MutexDAST", mutexLatency);
+
+        // Store results for CSV
+        results.push_back(row);
+
+        vector<double> latencyRow = {(double)numThreads};
+        for (const auto* histogram : {&mutexLatency, &shardedLatency, &combiningLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/flat_combining_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/flat_combining_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
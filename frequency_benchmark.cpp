@@ -0,0 +1,156 @@
+#include "bits/stdc++.h"
+#include "internal/original_splay_tree.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/splay_policy.h"
+#include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+int main(int argc, char* argv[]) {
+    dast::DepthAwareSplayTree dastTree;
+    dast::BasicDepthAwareSplayTree<splay_policy::Frequency<>> frequencyTree;
+    ost::SplayTree tree;
+
+    // Test parameters
+    int testSize = 1000000;
+    int hotSetSize = 1000;
+    int numAccess = 2000000;
+    vector<double> scanShares = {0, 0.05, 0.1, 0.25, 0.5};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"ScanShare", "DepthAwareSplayTree(hot)", "FrequencyDAST(hot)", "OriginalSplayTree(hot)",
+                              "DepthAwareSplayTree(scan)", "FrequencyDAST(scan)", "OriginalSplayTree(scan)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"ScanShare"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (double scanShare : scanShares) {
+        cout << "Testing scan share: " << scanShare << endl;
+
+        // Generate test data
+        auto testData = test::generateHotSetScanTest(testSize, hotSetSize, numAccess, scanShare);
+
+        // Clear previous tree data
+        dastTree.clear();
+        frequencyTree.clear();
+        tree.clear();
+
+        // Insert phase
+        for (const auto& q : testData) {
+            if (q.first == 0) {
+                dastTree.insert(q.second);
+                frequencyTree.insert(q.second);
+                tree.insert(q.second);
+            }
+        }
+
+        // Measure time for each tree, split into hot-set finds [0] and scan finds [1]
+        double dastResult[2] = {0, 0}, frequencyResult[2] = {0, 0}, treeResult[2] = {0, 0};
+        int count[2] = {0, 0};
+        latency::Histogram dastLatency[2], frequencyLatency[2], treeLatency[2];
+
+        for (const auto& q : testData) {
+            if (q.first == 0) continue;
+            int kind = q.first - 1;
+            count[kind]++;
+
+            // Measure Depth-Aware Splay Tree
+            auto start = high_resolution_clock::now();
+            dastTree.lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            dastResult[kind] += duration_cast<duration<double>>(end - start).count();
+            dastLatency[kind].record(end - start);
+
+            // Measure Depth-Aware Splay Tree with hit counters
+            start = high_resolution_clock::now();
+            frequencyTree.lower_bound(q.second);
+            end = high_resolution_clock::now();
+            frequencyResult[kind] += duration_cast<duration<double>>(end - start).count();
+            frequencyLatency[kind].record(end - start);
+
+            // Measure Original Splay Tree
+            start = high_resolution_clock::now();
+            tree.lower_bound(q.second);
+            end = high_resolution_clock::now();
+            treeResult[kind] += duration_cast<duration<double>>(end - start).count();
+            treeLatency[kind].record(end - start);
+        }
+
+        // Average times (convert to microseconds)
+        vector<double> row = {scanShare};
+        for (auto result : {dastResult, frequencyResult, treeResult})
+            row.push_back(count[0] ? result[0] / count[0] * 1e6 : 0);
+        for (auto result : {dastResult, frequencyResult, treeResult})
+            row.push_back(count[1] ? result[1] / count[1] * 1e6 : 0);
+
+        // Print results for the current scan share
+        cout << "Scan Share: " << scanShare;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i] << "us";
+        cout << endl;
+
+        // Flag a tail regression of the hot set under hit counting
+        regressed |= latency::compare_tail("FrequencyDAST(hot)", frequencyLatency[0], "DepthAwareSplayTree(hot)", dastLatency[0]);
+
+        // Store results for CSV
+        results.push_back(row);
+
+        vector<double> latencyRow = {scanShare};
+        for (int kind : {0, 1}) {
+            for (const auto* histogram : {&dastLatency[kind], &frequencyLatency[kind], &treeLatency[kind]}) {
+                auto summary = histogram->summary();
+                latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+            }
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/frequency_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/frequency_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
@@ -0,0 +1,767 @@
+#include "bits/stdc++.h"
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/dast_index.h"
+#include "internal/sum_query_dast.h"
+#include "internal/analysis_dast.h"
+#include "internal/hot_cache_dast.h"
+#include "internal/test_gen.h"
+
+using namespace __gnu_pbds;
+using namespace std;
+using namespace chrono;
+
+typedef tree<int, null_type, less<int>, rb_tree_tag, tree_order_statistics_node_update> ordered_set;
+
+// Keys paired with an insertion id, so that the reference can hold duplicates
+typedef tree<pair<int, int>, null_type, less<pair<int, int>>, rb_tree_tag, tree_order_statistics_node_update> ordered_multiset;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Read a CSV written by writeCSV; returns false if the file is missing
+bool readCSV(const string& filename, vector<string>& columns, vector<vector<double>>& data) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    string line, cell;
+    columns.clear();
+    data.clear();
+
+    if (getline(file, line)) {
+        stringstream header(line);
+        while (getline(header, cell, ',')) {
+            columns.push_back(cell);
+        }
+    }
+
+    while (getline(file, line)) {
+        stringstream row(line);
+        data.emplace_back();
+        while (getline(row, cell, ',')) {
+            data.back().push_back(stod(cell));
+        }
+    }
+
+    return true;
+}
+
+// Capabilities of the trees under test, so that one replay loop covers
+// every variant and checks whatever each one maintains
+template <typename T, typename = void> struct has_size : false_type {};
+template <typename T> struct has_size<T, void_t<decltype(declval<T&>().size)>> : true_type {};
+
+template <typename T, typename = void> struct has_sum : false_type {};
+template <typename T> struct has_sum<T, void_t<decltype(declval<T&>().sum)>> : true_type {};
+
+template <typename T, typename = void> struct has_order_of_key : false_type {};
+template <typename T> struct has_order_of_key<T, void_t<decltype(declval<T&>().order_of_key(0))>> : true_type {};
+
+template <typename T, typename = void> struct has_node_at_index : false_type {};
+template <typename T> struct has_node_at_index<T, void_t<decltype(declval<T&>().node_at_index(0))>> : true_type {};
+
+template <typename T, typename = void> struct has_range_sum : false_type {};
+template <typename T>
+struct has_range_sum<T, void_t<decltype(declval<T&>().range_sum(declval<T&>().root, declval<T&>().root))>> : true_type {};
+
+template <typename T, typename = void> struct has_min_node : false_type {};
+template <typename T> struct has_min_node<T, void_t<decltype(declval<T&>().min_node)>> : true_type {};
+
+template <typename T, typename = void> struct has_pop : false_type {};
+template <typename T> struct has_pop<T, void_t<decltype(declval<T&>().pop_min())>> : true_type {};
+
+template <typename T, typename = void> struct has_decrease_key : false_type {};
+template <typename T>
+struct has_decrease_key<T, void_t<decltype(declval<T&>().decrease_key(declval<T&>().lower_bound(0), 0))>> : true_type {};
+
+template <typename T, typename = void> struct has_handle : false_type {};
+template <typename T> struct has_handle<T, void_t<decltype(declval<T&>().handle(nullptr))>> : true_type {};
+
+template <typename T, typename = void> struct has_compact : false_type {};
+template <typename T> struct has_compact<T, void_t<decltype(declval<T&>().compact())>> : true_type {};
+
+template <typename T, typename = void> struct has_meld : false_type {};
+template <typename T> struct has_meld<T, void_t<decltype(declval<T&>().meld(declval<T&>()))>> : true_type {};
+
+// Front ends such as hot_cache wrap the tree they serve as a member
+template <typename T, typename = void> struct has_inner_tree : false_type {};
+template <typename T> struct has_inner_tree<T, void_t<decltype(declval<T&>().tree.root)>> : true_type {};
+
+template <typename Tree>
+const auto& innerTree(const Tree& tree) {
+    if constexpr (has_inner_tree<Tree>::value)
+        return tree.tree;
+    else
+        return tree;
+}
+
+enum class Operation {
+    Insert, Remove, LowerBound, OrderOfKey, AtIndex, RangeSum,
+    PopMin, PopMax, DecreaseKey, RemoveHandle, Compact, Meld
+};
+
+struct Op {
+    Operation operation;
+    int key;
+    int key2 = 0;
+    vector<int> batch = {};  // Keys of the tree melded in by Meld
+};
+
+string describe(const Op& op) {
+    static const char* names[] = {"insert", "remove", "lower_bound", "order_of_key", "node_at_index", "range_sum",
+                                  "pop_min", "pop_max", "decrease_key", "remove(handle)", "compact", "meld"};
+    string text = string(names[int(op.operation)]) + " " + to_string(op.key);
+    if (op.operation == Operation::RangeSum || op.operation == Operation::DecreaseKey) text += " " + to_string(op.key2);
+    if (op.operation == Operation::Meld) text += " (" + to_string(op.batch.size()) + " keys)";
+    return text;
+}
+
+// Walk the whole tree and check parent pointers, BST order, the size and
+// sum augmentations where the node has them, the tree's size counter and
+// the cached min/max nodes. Iterative, since adversarial streams build
+// paths as deep as the tree is large. Returns an empty string if all hold.
+template <typename Tree>
+string checkInvariants(const Tree& tree) {
+    using Node = remove_pointer_t<decltype(tree.root)>;
+
+    if (tree.root && tree.root->parent != nullptr) return "root has a parent";
+
+    // Preorder, checking that every child points back at its parent
+    vector<const Node*> preorder;
+    vector<const Node*> stack;
+    if (tree.root) stack.push_back(tree.root);
+    while (!stack.empty()) {
+        const Node* x = stack.back();
+        stack.pop_back();
+        preorder.push_back(x);
+        for (const Node* c : x->child) {
+            if (c == nullptr) continue;
+            if (c->parent != x) return "parent pointer of " + to_string(c->key) + " is wrong";
+            stack.push_back(c);
+        }
+    }
+
+    if (int(preorder.size()) != tree.size)
+        return "size counter is " + to_string(tree.size) + " but the tree holds " + to_string(preorder.size());
+
+    // Subtree counts and sums bottom up
+    unordered_map<const Node*, pair<int, long long>> subtree;
+    for (auto it = preorder.rbegin(); it != preorder.rend(); ++it) {
+        const Node* x = *it;
+        int count = 1;
+        long long sum = x->key;
+        for (const Node* c : x->child) {
+            if (c == nullptr) continue;
+            count += subtree[c].first;
+            sum += subtree[c].second;
+        }
+        subtree[x] = {count, sum};
+
+        if constexpr (has_size<Node>::value) {
+            if (x->size != count)
+                return "size of " + to_string(x->key) + " is " + to_string(x->size) + ", expected " + to_string(count);
+        }
+        if constexpr (has_sum<Node>::value) {
+            if (x->sum != sum)
+                return "sum of " + to_string(x->key) + " is " + to_string(x->sum) + ", expected " + to_string(sum);
+        }
+    }
+
+    // In-order keys must not decrease
+    const Node* previous = nullptr;
+    const Node* current = tree.root;
+    while (current != nullptr || !stack.empty()) {
+        while (current != nullptr) {
+            stack.push_back(current);
+            current = current->child[0];
+        }
+        current = stack.back();
+        stack.pop_back();
+        if (previous && previous->key > current->key)
+            return "keys out of order: " + to_string(previous->key) + " before " + to_string(current->key);
+        previous = current;
+        current = current->child[1];
+    }
+
+    if constexpr (has_min_node<Tree>::value) {
+        const Node* leftmost = tree.root;
+        const Node* rightmost = tree.root;
+        while (leftmost && leftmost->child[0]) leftmost = leftmost->child[0];
+        while (rightmost && rightmost->child[1]) rightmost = rightmost->child[1];
+        if ((tree.min_node == nullptr) != (leftmost == nullptr) || (leftmost && tree.min_node->key != leftmost->key))
+            return "min_node is stale";
+        if ((tree.max_node == nullptr) != (rightmost == nullptr) || (rightmost && tree.max_node->key != rightmost->key))
+            return "max_node is stale";
+    }
+
+    return "";
+}
+
+// Replay ops against tree and against std::multiset / PBDS references,
+// comparing every answer and checking the invariants every checkInterval
+// operations. Operations the tree does not support are skipped. Returns an
+// empty string on success, else the first mismatch.
+template <typename Tree>
+string replay(const vector<Op>& ops, int checkInterval, const function<void(Tree&)>& configure) {
+    Tree tree;
+    if (configure) configure(tree);
+    multiset<int> reference;
+    ordered_multiset ranked;
+    int nextId = 0;
+
+    auto expectKey = [](auto* x, multiset<int>::iterator it, multiset<int>::iterator end) -> string {
+        if ((x == nullptr) != (it == end))
+            return x ? "got " + to_string(x->key) + ", expected none" : "got none, expected " + to_string(*it);
+        if (x && x->key != *it)
+            return "got " + to_string(x->key) + ", expected " + to_string(*it);
+        return "";
+    };
+
+    for (size_t i = 0; i < ops.size(); i++) {
+        const Op& op = ops[i];
+        string error;
+
+        switch (op.operation) {
+        case Operation::Insert:
+            tree.insert(op.key);
+            reference.insert(op.key);
+            ranked.insert({op.key, nextId++});
+            break;
+
+        case Operation::Remove: {
+            auto x = tree.lower_bound(op.key);
+            bool found = x && x->key == op.key;
+            if (found != (reference.count(op.key) > 0)) {
+                error = found ? "removed a key the reference lacks" : "missed a key the reference holds";
+                break;
+            }
+            if (found) {
+                tree.remove(x);
+                reference.erase(reference.find(op.key));
+                ranked.erase(ranked.lower_bound({op.key, INT_MIN}));
+            }
+            break;
+        }
+
+        case Operation::LowerBound:
+            error = expectKey(tree.lower_bound(op.key), reference.lower_bound(op.key), reference.end());
+            break;
+
+        case Operation::OrderOfKey:
+            if constexpr (has_order_of_key<Tree>::value) {
+                int got = tree.order_of_key(op.key);
+                int expected = ranked.order_of_key({op.key, INT_MIN});
+                if (got != expected)
+                    error = "got " + to_string(got) + ", expected " + to_string(expected);
+            }
+            break;
+
+        case Operation::AtIndex:
+            if constexpr (has_node_at_index<Tree>::value) {
+                int index = op.key % (int(reference.size()) + 1);
+                auto x = tree.node_at_index(index);
+                bool inRange = index < int(ranked.size());
+                if ((x == nullptr) == inRange)
+                    error = x ? "got a node past the end" : "got none for an index in range";
+                else if (x && x->key != ranked.find_by_order(index)->first)
+                    error = "got " + to_string(x->key) + ", expected " + to_string(ranked.find_by_order(index)->first);
+            }
+            break;
+
+        case Operation::RangeSum:
+            if constexpr (has_range_sum<Tree>::value) {
+                // range_sum(l, r) sums the nodes strictly between l and r in
+                // key order; lower_bound returns the first of equal keys
+                auto l = tree.lower_bound(op.key);
+                auto r = tree.lower_bound(op.key2);
+                if (l == nullptr || r == nullptr || l->key >= r->key) break;
+
+                long long expected = -l->key;
+                for (auto it = reference.lower_bound(l->key); it != reference.end() && *it < r->key; ++it)
+                    expected += *it;
+                long long got = tree.range_sum(l, r);
+                if (got != expected)
+                    error = "got " + to_string(got) + ", expected " + to_string(expected);
+            }
+            break;
+
+        case Operation::PopMin:
+        case Operation::PopMax:
+            if constexpr (has_pop<Tree>::value) {
+                if (reference.empty()) break;
+                bool popMin = op.operation == Operation::PopMin;
+                int expected = popMin ? *reference.begin() : *reference.rbegin();
+                int got = popMin ? tree.pop_min() : tree.pop_max();
+                if (got != expected) {
+                    error = "got " + to_string(got) + ", expected " + to_string(expected);
+                    break;
+                }
+                reference.erase(reference.find(expected));
+                ranked.erase(ranked.lower_bound({expected, INT_MIN}));
+            }
+            break;
+
+        case Operation::DecreaseKey:
+            if constexpr (has_decrease_key<Tree>::value) {
+                auto x = tree.lower_bound(op.key);
+                bool found = x && x->key == op.key;
+                if (found != (reference.count(op.key) > 0)) {
+                    error = found ? "found a key the reference lacks" : "missed a key the reference holds";
+                    break;
+                }
+                if (!found || op.key2 <= 0) break;
+
+                // Front ends are also re-keyed behind their back now and
+                // then, which they must notice on their own
+                int key = op.key - op.key2;
+                if constexpr (has_inner_tree<Tree>::value) {
+                    if (op.key2 % 2)
+                        tree.tree.decrease_key(x, key);
+                    else
+                        tree.decrease_key(x, key);
+                } else {
+                    tree.decrease_key(x, key);
+                }
+                if (x->key != key) {
+                    error = "node holds " + to_string(x->key) + ", expected " + to_string(key);
+                    break;
+                }
+                reference.erase(reference.find(op.key));
+                reference.insert(key);
+                ranked.erase(ranked.lower_bound({op.key, INT_MIN}));
+                ranked.insert({key, nextId++});
+
+                // The old key must no longer find the node
+                error = expectKey(tree.lower_bound(op.key), reference.lower_bound(op.key), reference.end());
+            }
+            break;
+
+        case Operation::RemoveHandle:
+            if constexpr (has_handle<Tree>::value) {
+                auto x = tree.lower_bound(op.key);
+                bool found = x && x->key == op.key;
+                if (found != (reference.count(op.key) > 0)) {
+                    error = found ? "found a key the reference lacks" : "missed a key the reference holds";
+                    break;
+                }
+                if (!found) break;
+
+                auto h = tree.handle(x);
+                if (Tree().get(h) != nullptr) {
+                    error = "another tree accepted the handle";
+                    break;
+                }
+                if (!tree.remove(h)) {
+                    error = "a live handle was rejected";
+                    break;
+                }
+                if (tree.get(h) != nullptr || tree.remove(h)) {
+                    error = "a handle stayed valid after its node was removed";
+                    break;
+                }
+                reference.erase(reference.find(op.key));
+                ranked.erase(ranked.lower_bound({op.key, INT_MIN}));
+            }
+            break;
+
+        case Operation::Compact:
+            if constexpr (has_compact<Tree>::value) {
+                // A handle taken before a relayout must follow its node,
+                // whether the relayout is asked for or set off by lookups
+                if constexpr (has_handle<Tree>::value) {
+                    auto x = tree.lower_bound(op.key);
+                    if (x == nullptr) {
+                        tree.compact();
+                        break;
+                    }
+                    auto h = tree.handle(x);
+                    int key = x->key;
+                    if (tree.compact_check_interval) {
+                        for (int i = 0; i <= tree.compact_check_interval; i++)
+                            tree.lower_bound(key);
+                        auto y = tree.get(h);
+                        if (y == nullptr || y->key != key) {
+                            error = "a handle was lost by an automatic relayout";
+                            break;
+                        }
+                    }
+                    tree.compact();
+                    auto y = tree.get(h);
+                    if (y == nullptr || y->key != key)
+                        error = "a handle was lost by compact";
+                } else {
+                    tree.compact();
+                }
+            }
+            break;
+
+        case Operation::Meld:
+            if constexpr (has_meld<Tree>::value) {
+                Tree other;
+                if (configure) configure(other);
+                for (int key : op.batch) {
+                    other.insert(key);
+                    reference.insert(key);
+                    ranked.insert({key, nextId++});
+                }
+                if ((error = checkInvariants(other)).empty()) {
+                    // Handles into either tree must resolve in the result
+                    if constexpr (has_handle<Tree>::value) {
+                        auto ours = tree.lower_bound(op.key), theirs = other.lower_bound(op.key);
+                        auto ourHandle = tree.handle(ours), theirHandle = other.handle(theirs);
+                        int ourKey = ours ? ours->key : 0, theirKey = theirs ? theirs->key : 0;
+                        tree.meld(other);
+                        auto x = tree.get(ourHandle), y = tree.get(theirHandle);
+                        if ((ours && (x == nullptr || x->key != ourKey)) || (theirs && (y == nullptr || y->key != theirKey)))
+                            error = "a handle was lost by meld";
+                        else if (theirs && other.get(theirHandle) != nullptr)
+                            error = "the melded tree still accepted its handle";
+                    } else {
+                        tree.meld(other);
+                    }
+                    if (error.empty() && (other.size != 0 || other.root != nullptr))
+                        error = "the melded tree was not left empty";
+                }
+            }
+            break;
+        }
+
+        if (error.empty() && ((i + 1) % checkInterval == 0 || i + 1 == ops.size()))
+            error = checkInvariants(innerTree(tree));
+
+        if (!error.empty())
+            return "op " + to_string(i) + " (" + describe(op) + "): " + error;
+    }
+
+    return "";
+}
+
+// Randomized and adversarial operation streams. Each is deterministic in
+// its seed, so a failure is reproduced by replaying the printed stream/seed.
+vector<Op> generateStream(const string& name, int seed, int numOps) {
+    mt19937 gen(seed);
+    vector<Op> ops;
+
+    // Mostly in-range keys, with the occasional extreme or absent one
+    auto queryKey = [&](int range) {
+        switch (gen() % 32) {
+        case 0: return INT_MIN;
+        case 1: return INT_MAX;
+        case 2: return -1;
+        case 3: return range;
+        default: return int(gen() % range);
+        }
+    };
+
+    // Keys of a tree to meld in: above or below every key in [0, range),
+    // a few keys among them, or about as many keys as the tree holds, so
+    // that every meld strategy is taken
+    auto meldBatch = [&](int range) {
+        vector<int> batch;
+        int mode = gen() % 5;
+        int count = mode >= 3 ? range / 4 + gen() % (range / 2 + 1) : 1 + gen() % 32;
+        int window = range / 16 + 1, low = gen() % range;
+        for (int i = 0; i < count; i++) {
+            if (mode == 0) batch.push_back(range + int(gen() % range));
+            else if (mode == 1) batch.push_back(-1 - int(gen() % range));
+            else if (mode == 4) batch.push_back(low + int(gen() % window));  // Few runs: a dense clump
+            else batch.push_back(gen() % range);
+        }
+        return batch;
+    };
+
+    // A mixed workload over keys in [0, range)
+    auto mixed = [&](int range, int count) {
+        for (int i = 0; i < count; i++) {
+            int roll = gen() % 1000;
+            if (roll < 380) ops.push_back({Operation::Insert, int(gen() % range)});
+            else if (roll < 560) ops.push_back({Operation::Remove, queryKey(range)});
+            else if (roll < 740) ops.push_back({Operation::LowerBound, queryKey(range)});
+            else if (roll < 810) ops.push_back({Operation::OrderOfKey, queryKey(range)});
+            else if (roll < 870) ops.push_back({Operation::AtIndex, int(gen() % (range + 1))});
+            else if (roll < 920) ops.push_back({Operation::RangeSum, queryKey(range), queryKey(range)});
+            else if (roll < 940) ops.push_back({Operation::PopMin, 0});
+            else if (roll < 960) ops.push_back({Operation::PopMax, 0});
+            else if (roll < 975) ops.push_back({Operation::DecreaseKey, int(gen() % range), int(gen() % (range / 4 + 1))});
+            else if (roll < 990) ops.push_back({Operation::RemoveHandle, queryKey(range)});
+            else if (roll < 995) ops.push_back({Operation::Compact, 0});
+            else ops.push_back({Operation::Meld, 0, 0, meldBatch(range)});
+        }
+    };
+
+    int n = numOps / 4;
+
+    if (name == "random") {
+        mixed(4 * n, numOps);
+    } else if (name == "duplicates") {
+        mixed(16, numOps);
+    } else if (name == "sorted" || name == "reverse") {
+        // One long path, then queries from its deep end and removals from both ends
+        for (int i = 0; i < n; i++)
+            ops.push_back({Operation::Insert, name == "sorted" ? i : n - 1 - i});
+        for (int i = 0; i < n; i++)
+            ops.push_back({Operation::LowerBound, name == "sorted" ? i : n - 1 - i});
+        for (int i = 0; i < n / 2; i++) {
+            ops.push_back({Operation::Remove, i});
+            ops.push_back({Operation::Remove, n - 1 - i});
+        }
+        mixed(n, numOps - int(ops.size()));
+    } else if (name == "zigzag") {
+        // Alternate ends so the tree is a zig-zag path, then hit its middle
+        for (int low = 0, high = n - 1; low <= high; low++, high--) {
+            ops.push_back({Operation::Insert, low});
+            if (low != high) ops.push_back({Operation::Insert, high});
+        }
+        for (int i = 0; i < n; i++)
+            ops.push_back({i % 2 ? Operation::LowerBound : Operation::OrderOfKey, n / 2 + (i % 3) - 1});
+        mixed(n, numOps - int(ops.size()));
+    } else if (name == "sawtooth") {
+        // Short ascending runs with the minimum removed after each
+        for (int i = 0; int(ops.size()) < numOps; i++) {
+            for (int j = 0; j < 8; j++)
+                ops.push_back({Operation::Insert, i * 4 + j});
+            ops.push_back({Operation::Remove, i * 4});
+            ops.push_back({Operation::AtIndex, int(gen() % (i * 8 + 1))});
+        }
+    } else if (name == "hot") {
+        // A few hot keys queried, removed and reinserted among random inserts
+        for (int i = 0; int(ops.size()) < numOps; i++) {
+            int hot = gen() % 8 * 1000;
+            int roll = gen() % 10;
+            if (roll < 3) ops.push_back({Operation::Insert, int(gen() % 8000)});
+            else if (roll < 8) ops.push_back({Operation::LowerBound, hot});
+            else if (roll < 9) ops.push_back({Operation::Remove, hot});
+            else ops.push_back({Operation::Insert, hot});
+        }
+    }
+
+    ops.resize(min<size_t>(ops.size(), numOps));
+    return ops;
+}
+
+// Replay every stream against one variant, set up by configure if given;
+// returns the number of failures
+template <typename Tree>
+int fuzzVariant(const string& variant, const vector<string>& streams, int seeds, int numOps,
+                const function<void(Tree&)>& configure = nullptr) {
+    int failures = 0;
+    for (const string& stream : streams) {
+        for (int seed = 0; seed < seeds; seed++) {
+            string error = replay<Tree>(generateStream(stream, seed, numOps), 64, configure);
+            if (!error.empty()) {
+                cout << "  FAIL: " << variant << " stream=" << stream << " seed=" << seed << " " << error << endl;
+                failures++;
+                break;  // Later seeds would most likely repeat the report
+            }
+        }
+    }
+    cout << "  " << variant << ": " << (failures ? "FAILED" : "ok") << endl;
+    return failures;
+}
+
+// Seconds taken by the lookups of testData on a structure built from its
+// inserts; the best of several rounds, each on a freshly built structure
+template <typename Structure, typename Lookup>
+double timeLookups(const test::TestType& testData, int rounds, Lookup lookup) {
+    double best = numeric_limits<double>::max();
+    for (int round = 0; round < rounds; round++) {
+        Structure structure;
+        for (const auto& q : testData) {
+            if (q.first == 0) {
+                structure.insert(q.second);
+            }
+        }
+
+        auto start = high_resolution_clock::now();
+        for (const auto& q : testData) {
+            if (q.first == 1) {
+                lookup(structure, q.second);
+            }
+        }
+        auto end = high_resolution_clock::now();
+        best = min(best, duration_cast<duration<double>>(end - start).count());
+    }
+    return best;
+}
+
+// Compare every cell of current against the baseline row with the same
+// TreeSize and the column with the same name. Throughput dropping by more
+// than tolerance percent is a regression. Returns whether any regressed.
+bool compareToBaseline(const vector<string>& columns, const vector<vector<double>>& current,
+                       const vector<string>& baselineColumns, const vector<vector<double>>& baseline, double tolerance) {
+    bool regressed = false;
+    for (const auto& row : current) {
+        auto baselineRow = find_if(baseline.begin(), baseline.end(), [&](const vector<double>& r) { return r[0] == row[0]; });
+        if (baselineRow == baseline.end()) continue;
+
+        for (size_t i = 1; i < columns.size(); i++) {
+            auto column = find(baselineColumns.begin(), baselineColumns.end(), columns[i]);
+            if (column == baselineColumns.end()) continue;
+            double before = (*baselineRow)[column - baselineColumns.begin()];
+            double drop = 100 * (1 - before / row[i]);
+            bool slower = drop > tolerance;
+            regressed |= slower;
+
+            cout << (slower ? "  REGRESSION: " : "  ok: ") << columns[i] << " @ " << int(row[0]) << " throughput "
+                 << (drop > 0 ? "-" : "+") << fixed << setprecision(1) << abs(drop) << "% (" << setprecision(6) << row[i]
+                 << "s vs " << before << "s)" << endl;
+            cout.unsetf(ios::fixed);
+        }
+    }
+    return regressed;
+}
+
+int main(int argc, char* argv[]) {
+    // Options
+    double tolerance = 20;
+    int seeds = 5;
+    bool fuzz = true, timing = true, updateBaseline = false;
+    string baselineDir = "output/fuzz_harness";
+    string currentDir = "build/fuzz_harness_current";  // Fresh runs, kept out of the source tree
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--tolerance" && i + 1 < argc) tolerance = stod(argv[++i]);
+        else if (arg == "--seeds" && i + 1 < argc) seeds = stoi(argv[++i]);
+        else if (arg == "--baseline-dir" && i + 1 < argc) baselineDir = argv[++i];
+        else if (arg == "--current-dir" && i + 1 < argc) currentDir = argv[++i];
+        else if (arg == "--update-baseline") updateBaseline = true;
+        else if (arg == "--skip-fuzz") fuzz = false;
+        else if (arg == "--skip-timing") timing = false;
+        else {
+            cerr << "usage: " << argv[0] << " [--tolerance PERCENT] [--seeds N] [--baseline-dir DIR] [--current-dir DIR]"
+                 << " [--update-baseline] [--skip-fuzz] [--skip-timing]" << endl;
+            return 2;
+        }
+    }
+
+    int failures = 0;
+    bool regressed = false;
+
+    if (fuzz) {
+        vector<string> streams = {"random", "duplicates", "sorted", "reverse", "zigzag", "sawtooth", "hot"};
+        int numOps = 4000;
+
+        cout << "Fuzzing " << streams.size() << " streams x " << seeds << " seeds" << endl;
+        failures += fuzzVariant<dast::DepthAwareSplayTree>("DepthAwareSplayTree", streams, seeds, numOps);
+
+        // Relayout as often as possible, so that lookups return relocated nodes
+        failures += fuzzVariant<dast::DepthAwareSplayTree>("DAST(auto-compact)", streams, seeds, numOps, [](auto& tree) {
+            tree.compact_check_interval = 4;
+            tree.compact_splay_rate = 1.0;
+        });
+        failures += fuzzVariant<dast::DepthAwareSplayTree>("DAST(prefetch)", streams, seeds, numOps,
+                                                           [](auto& tree) { tree.prefetch = true; });
+        failures += fuzzVariant<dast::DepthAwareSplayTree>("DAST(partial splay)", streams, seeds, numOps,
+                                                           [](auto& tree) { tree.partial_splay_fraction = 0.5; });
+        failures += fuzzVariant<dast::DepthAwareSplayTree>("DAST(all options)", streams, seeds, numOps, [](auto& tree) {
+            tree.prefetch = true;
+            tree.partial_splay_fraction = 0.5;
+            tree.compact_check_interval = 16;
+            tree.compact_splay_rate = 0.5;
+            tree.compact_bfs_levels = 2;
+        });
+
+        // Every splay policy
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::LogDepth<ratio<0>>>>("DAST(always splay)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::ClzDepth>>("DAST(ClzDepth)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::Random<>>>("DAST(Random)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::Periodic<>>>("DAST(Periodic)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::DepthRecency<>>>("DAST(DepthRecency)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::Frequency<2, 256>>>("DAST(Frequency)", streams, seeds, numOps);
+        failures += fuzzVariant<dast::BasicDepthAwareSplayTree<splay_policy::Deferred<>>>("DAST(Deferred)", streams, seeds, numOps,
+                                                                                         [](auto& tree) { tree.policy.deferred = true; });
+
+        failures += fuzzVariant<hot_cache::DepthAwareSplayTree>("HotCacheDAST", streams, seeds, numOps);
+        failures += fuzzVariant<hot_cache::DirectMappedDepthAwareSplayTree>("HotCacheDAST(auto-compact)", streams, seeds, numOps,
+                                                                             [](auto& cached) {
+            cached.tree.compact_check_interval = 4;
+            cached.tree.compact_splay_rate = 1.0;
+        });
+        failures += fuzzVariant<dast_index::DepthAwareSplayTree>("DastIndex", streams, seeds, numOps);
+        failures += fuzzVariant<sum_query_dast::DepthAwareSplayTree>("SumQueryDAST", streams, seeds, numOps);
+        failures += fuzzVariant<analysis::DepthAwareSplayTree>("AnalysisDAST", streams, seeds, numOps);
+    }
+
+    if (timing) {
+        int numAccess = 1000000;
+        int rounds = 5;
+        vector<int> testSizes = {1000, 100000};
+        vector<string> columns = {"TreeSize", "std::set", "PBDS", "DepthAwareSplayTree", "DastIndex", "SumQueryDAST", "AnalysisDAST"};
+
+        map<string, function<test::TestType(int)>> workloads = {
+            {"random", [&](int testSize) { return test::generateTestData(testSize, numAccess); }},
+            {"cache", [&](int testSize) { return test::generateCacheAccessTest(testSize, max(1, testSize / 100), numAccess); }},
+        };
+
+        for (auto& [workload, generate] : workloads) {
+            vector<vector<double>> results;
+
+            for (int testSize : testSizes) {
+                cout << "Timing " << workload << " lookups, tree size: " << testSize << endl;
+                auto testData = generate(testSize);
+                [[maybe_unused]] const void* volatile sink = nullptr;  // Keeps side-effect free lookups from being optimized out
+
+                results.push_back({double(testSize),
+                    timeLookups<set<int>>(testData, rounds, [&](auto& s, int key) { sink = &*s.lower_bound(key); }),
+                    timeLookups<ordered_set>(testData, rounds, [&](auto& s, int key) { sink = &*s.lower_bound(key); }),
+                    timeLookups<dast::DepthAwareSplayTree>(testData, rounds, [&](auto& t, int key) { sink = t.lower_bound(key); }),
+                    timeLookups<dast_index::DepthAwareSplayTree>(testData, rounds, [&](auto& t, int key) { sink = t.lower_bound(key); }),
+                    timeLookups<sum_query_dast::DepthAwareSplayTree>(testData, rounds, [&](auto& t, int key) { sink = t.lower_bound(key); }),
+                    timeLookups<analysis::DepthAwareSplayTree>(testData, rounds, [&](auto& t, int key) { sink = t.lower_bound(key); })});
+            }
+
+            // The stored run is the baseline; a fresh run is written to
+            // currentDir and only replaces the baseline on request
+            string baselineFile = baselineDir + "/" + workload + ".csv";
+            vector<string> baselineColumns;
+            vector<vector<double>> baseline;
+
+            if (!updateBaseline && readCSV(baselineFile, baselineColumns, baseline)) {
+                cout << "Comparing " << workload << " against " << baselineFile << " (tolerance " << tolerance << "%)" << endl;
+                regressed |= compareToBaseline(columns, results, baselineColumns, baseline, tolerance);
+                filesystem::create_directories(currentDir);
+                writeCSV(results, columns, currentDir + "/" + workload + ".csv");
+            } else {
+                writeCSV(results, columns, baselineFile);
+            }
+        }
+    }
+
+    if (failures) cout << failures << " fuzzing failure(s)" << endl;
+    if (regressed) cout << "Throughput regressed beyond " << tolerance << "%" << endl;
+    return failures || regressed ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Session-table churn: the tree holds testSize live entries, and each step
+// expires a random live entry and admits a new one. The caller keeps an
+// entry per session; removing it either looks the key up again or uses a
+// handle saved at insert time. Returns microseconds per step and records
+// each step in histogram.
+double measureChurn(int testSize, int numSteps, bool useHandles, latency::Histogram& histogram) {
+    dast::DepthAwareSplayTree dastTree;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+
+    vector<int> keys;
+    vector<dast::Handle> handles;
+    int nextKey = 0;
+    for (int i = 0; i < testSize; i++) {
+        keys.push_back(nextKey);
+        handles.push_back(dastTree.handle(dastTree.insert(nextKey++)));
+    }
+
+    double total = 0;
+    for (int step = 0; step < numSteps; step++) {
+        int victim = gen() % testSize;
+
+        auto start = high_resolution_clock::now();
+        if (useHandles) {
+            dastTree.remove(handles[victim]);
+        } else {
+            dastTree.remove(dastTree.lower_bound(keys[victim]));
+        }
+
+        keys[victim] = nextKey;
+        handles[victim] = dastTree.handle(dastTree.insert(nextKey++));
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(end - start);
+    }
+
+    if (dastTree.size != testSize) cerr << "Error: tree size drifted to " << dastTree.size << endl;
+    return total / numSteps * 1e6;
+}
+
+// Cost of validating handles, half of them stale; microseconds per check
+double measureValidation(int testSize, int numChecks) {
+    dast::DepthAwareSplayTree dastTree;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+
+    vector<dast::Handle> handles;
+    for (int i = 0; i < testSize; i++) handles.push_back(dastTree.handle(dastTree.insert(i)));
+    for (int i = 0; i < testSize; i += 2) dastTree.remove(handles[i]);
+
+    vector<int> order(numChecks);
+    for (int& i : order) i = gen() % testSize;
+
+    int valid = 0;
+    auto start = high_resolution_clock::now();
+    for (int i : order) valid += dastTree.get(handles[i]) != nullptr;
+    auto end = high_resolution_clock::now();
+
+    if (valid == 0 || valid == numChecks) cerr << "Error: handle validation is one-sided" << endl;
+    return duration_cast<duration<double>>(end - start).count() / numChecks * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numSteps = 1000000;
+    vector<int> testSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "RemoveByLookup", "RemoveByHandle", "HandleCheck"};
+
+    // Latency percentile columns (microseconds); a handle check takes a
+    // few nanoseconds, below what a per-call clock read can resolve, so it
+    // stays timed as a whole loop
+    vector<string> latencyColumns = {"TreeSize"};
+    for (size_t i = 1; i < 3; i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        latency::Histogram lookupLatency, handleLatency;
+        double lookupTime = measureChurn(testSize, numSteps, false, lookupLatency);
+        double handleTime = measureChurn(testSize, numSteps, true, handleLatency);
+        double checkTime = measureValidation(testSize, numSteps);
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize
+             << ", Remove by lookup: " << lookupTime << "us"
+             << ", Remove by handle: " << handleTime << "us"
+             << ", Handle check: " << checkTime << "us" << endl;
+
+        // Flag a tail regression of removal by handle
+        regressed |= latency::compare_tail("RemoveByHandle", handleLatency, "RemoveByLookup", lookupLatency);
+
+        // Store results for CSV
+        results.push_back({(double)testSize, lookupTime, handleTime, checkTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&lookupLatency, &handleLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/handle_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/handle_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
@@ -0,0 +1,137 @@
+#include "bits/stdc++.h"
+#include "internal/hot_cache_dast.h"
+#include "internal/test_gen.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Time the lookups of testData as one loop; per-lookup clock reads would
+// cost more than a cache hit
+template <typename Lookup>
+double timeLookups(const test::TestType& testData, Lookup lookup) {
+    [[maybe_unused]] const dast::Node* volatile sink = nullptr;  // Keeps the lookups from being optimized out
+    auto start = high_resolution_clock::now();
+    for (const auto& q : testData) {
+        if (q.first == 1) {
+            sink = lookup(q.second);
+        }
+    }
+    auto end = high_resolution_clock::now();
+    return duration_cast<duration<double>>(end - start).count();
+}
+
+int main() {
+    // Test parameters
+    int testSize = 1000000;
+    int numAccess = 2000000;
+    int cacheEntries = 2048;
+    vector<int> cachePoolSizes = {1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1000000};
+
+    // Result storage
+    vector<vector<double>> results;
+
+    // Column headers
+    vector<string> columns = {"CachePoolSize", "DepthAwareSplayTree", "HotCacheDAST(direct)", "HotCacheDAST(2-way)",
+                              "HitRate(direct)", "HitRate(2-way)"};
+
+    // Both caches hold the same number of entries
+    dast::DepthAwareSplayTree dastTree;
+    hot_cache::DirectMappedDepthAwareSplayTree directTree(cacheEntries);
+    hot_cache::DepthAwareSplayTree twoWayTree(cacheEntries / 2);
+
+    // Smallest pool size at which each cache is slower than the bare tree
+    int directCrossover = 0, twoWayCrossover = 0;
+
+    for (int cachePoolSize : cachePoolSizes) {
+        cout << "Testing cache pool size: " << cachePoolSize << endl;
+
+        // Generate test data
+        auto testData = test::generateCacheAccessTest(testSize, cachePoolSize, numAccess);
+
+        // Clear previous tree data
+        dastTree.clear();
+        directTree.clear();
+        twoWayTree.clear();
+        directTree.hits = directTree.misses = 0;
+        twoWayTree.hits = twoWayTree.misses = 0;
+
+        // Insert phase
+        for (const auto& q : testData) {
+            if (q.first == 0) {
+                dastTree.insert(q.second);
+                directTree.insert(q.second);
+                twoWayTree.insert(q.second);
+            }
+        }
+
+        // Measure time for each tree
+        double dastResult = timeLookups(testData, [&](int key) { return dastTree.lower_bound(key); });
+        double directResult = timeLookups(testData, [&](int key) { return directTree.lower_bound(key); });
+        double twoWayResult = timeLookups(testData, [&](int key) { return twoWayTree.lower_bound(key); });
+
+        // Average times (convert to microseconds)
+        double avgDastTime = dastResult / numAccess * 1e6;
+        double avgDirectTime = directResult / numAccess * 1e6;
+        double avgTwoWayTime = twoWayResult / numAccess * 1e6;
+        double directHitRate = double(directTree.hits) / numAccess;
+        double twoWayHitRate = double(twoWayTree.hits) / numAccess;
+
+        // Print results for the current cache pool size
+        cout << "Cache Pool Size: " << cachePoolSize
+             << ", Depth-Aware Splay Tree: " << avgDastTime << "us"
+             << ", Direct-Mapped Cache: " << avgDirectTime << "us (hit rate " << directHitRate << ")"
+             << ", 2-Way Cache: " << avgTwoWayTime << "us (hit rate " << twoWayHitRate << ")" << endl;
+
+        if (!directCrossover && avgDirectTime > avgDastTime) directCrossover = cachePoolSize;
+        if (!twoWayCrossover && avgTwoWayTime > avgDastTime) twoWayCrossover = cachePoolSize;
+
+        // Store results
+        results.push_back({double(cachePoolSize), avgDastTime, avgDirectTime, avgTwoWayTime, directHitRate, twoWayHitRate});
+    }
+
+    for (auto [name, crossover] : {pair<string, int>{"Direct-mapped", directCrossover}, {"2-way", twoWayCrossover}}) {
+        cout << name << " cache (" << cacheEntries << " entries): ";
+        if (crossover)
+            cout << "slower than the bare tree from pool size " << crossover << endl;
+        else
+            cout << "faster than the bare tree at every pool size" << endl;
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/hot_cache_benchmark/results.csv");
+
+    return 0;
+}
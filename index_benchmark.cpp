@@ -0,0 +1,141 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/dast_index.h"
+#include "internal/index_dast.h"
+#include "internal/memory_counter.h"
+#include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Build a tree from the test data, returning its heap bytes per key and
+// average lookup time in microseconds; each lookup is also recorded in
+// histogram
+template <typename Tree>
+pair<double, double> runTree(const test::TestType& testData, int testSize, latency::Histogram& histogram) {
+    size_t before = memory::current_bytes();
+    Tree dastTree;
+
+    for (const auto& q : testData) {
+        if (q.first == 0) {
+            dastTree.insert(q.second);
+        }
+    }
+
+    double bytesPerKey = double(memory::current_bytes() - before) / testSize;
+    double total = 0;
+    int count = 0;
+
+    for (const auto& q : testData) {
+        if (q.first == 1) {
+            auto start = high_resolution_clock::now();
+            dastTree.lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            total += duration_cast<duration<double>>(end - start).count();
+            histogram.record(end - start);
+            count++;
+        }
+    }
+
+    return {bytesPerKey, total / count * 1e6};
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numAccess = 1000000;
+    vector<int> testSizes = {1000000, 16000000, 64000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "DepthAwareSplayTree", "IndexDAST", "DastIndex", "IndexDAST(size)",
+                              "DepthAwareSplayTree(bytes/key)", "IndexDAST(bytes/key)", "DastIndex(bytes/key)", "IndexDAST(size)(bytes/key)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (size_t i = 1; i <= 4; i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        // Generate test data
+        auto testData = test::generateTestData(testSize, numAccess);
+
+        // One tree at a time, so the largest sizes fit in memory
+        vector<latency::Histogram> histograms(4);
+        vector<pair<double, double>> runs = {
+            runTree<dast::DepthAwareSplayTree>(testData, testSize, histograms[0]),
+            runTree<index_dast::DepthAwareSplayTree<>>(testData, testSize, histograms[1]),
+            runTree<dast_index::DepthAwareSplayTree>(testData, testSize, histograms[2]),
+            runTree<index_dast::DepthAwareSplayTree<index_dast::Size>>(testData, testSize, histograms[3]),
+        };
+
+        vector<double> row = {(double)testSize};
+        for (const auto& run : runs) row.push_back(run.second);
+        for (const auto& run : runs) row.push_back(run.first);
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i];
+        cout << endl;
+
+        // Flag a tail regression of the index-linked layout
+        regressed |= latency::compare_tail("IndexDAST", histograms[1], "DepthAwareSplayTree", histograms[0]);
+
+        // Store results for CSV
+        results.push_back(row);
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto& histogram : histograms) {
+            auto summary = histogram.summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/index_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/index_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
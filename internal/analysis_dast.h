@@ -1,5 +1,5 @@
-#ifndef DEPTH_AWARE_SPLAY_TREE_H
-#define DEPTH_AWARE_SPLAY_TREE_H
+#ifndef ANALYSIS_DAST_H
+#define ANALYSIS_DAST_H
 
 #include <bits/stdc++.h>
 using namespace std;
@@ -36,7 +36,7 @@ struct DepthAwareSplayTree {
     int threshold = 0;
 
     int get_depth_threshold() {
-        return max(4, (31 - __builtin_clz(size)) << 1);
+        return size > 0 ? max(4, (31 - __builtin_clz(size)) << 1) : 4;
     }
 
     Node *root = nullptr;
@@ -137,11 +137,13 @@ struct DepthAwareSplayTree {
         Node *left_subtree = x->child[0];
         Node *right_subtree = x->child[1];
 
+        x->child[0] = x->child[1] = nullptr;
         delete x; // Free memory for the node
 
         if (!left_subtree) {
             set_root(right_subtree);
         } else {
+            set_root(left_subtree);
             Node *max_left = left_subtree;
             while (max_left->child[1]) {
                 max_left = max_left->child[1];
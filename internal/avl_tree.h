@@ -0,0 +1,111 @@
+#ifndef AVL_TREE_H
+#define AVL_TREE_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace avl {
+
+// Node structure for the AVL tree
+struct Node {
+    Node *child[2] = {nullptr, nullptr};
+    int key;
+    int height = 1;
+
+    friend int get_height(Node *x) {
+        return x == nullptr ? 0 : x->height;
+    }
+
+    void join() {
+        height = max(get_height(child[0]), get_height(child[1])) + 1;
+    }
+
+    // Height of the right subtree minus the left
+    int balance() const {
+        return get_height(child[1]) - get_height(child[0]);
+    }
+};
+
+// AVL tree baseline for comparative benchmarks
+struct AVLTree {
+    int size = 0;
+    Node *root = nullptr;
+
+    // Rotate the given child of *x above x
+    static void rotate(Node *&x, int index) {
+        Node *c = x->child[index];
+        x->child[index] = c->child[!index];
+        c->child[!index] = x;
+        x->join();
+        c->join();
+        x = c;
+    }
+
+    // Restore the height invariant at x after one of its subtrees grew
+    static void rebalance(Node *&x) {
+        x->join();
+        int balance = x->balance();
+        if (abs(balance) < 2)
+            return;
+
+        int index = int(balance > 0);
+        Node *&c = x->child[index];
+        if ((c->balance() > 0) != bool(index) && c->balance() != 0)
+            rotate(c, !index); // Double rotation: straighten the zig-zag first
+        rotate(x, index);
+    }
+
+    static void insert(Node *&x, Node *node) {
+        if (x == nullptr) {
+            x = node;
+            return;
+        }
+
+        insert(x->child[x->key < node->key], node);
+        rebalance(x);
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+        Node *x = new Node();
+        x->key = key;
+        insert(root, x);
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) const {
+        const int *answer = nullptr;
+        for (Node *current = root; current != nullptr;) {
+            if (current->key < key) {
+                current = current->child[1];
+            } else {
+                answer = &current->key;
+                current = current->child[0];
+            }
+        }
+        return answer;
+    }
+
+    static void destroy(Node *x) {
+        if (x == nullptr) return;
+        destroy(x->child[0]);
+        destroy(x->child[1]);
+        delete x;
+    }
+
+    // Clear the entire tree
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        size = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~AVLTree() {
+        clear();
+    }
+};
+
+}
+#endif
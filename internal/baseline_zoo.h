@@ -0,0 +1,72 @@
+#ifndef BASELINE_ZOO_H
+#define BASELINE_ZOO_H
+
+#include <bits/stdc++.h>
+#include "depth_aware_splay_tree.h"
+#include "original_splay_tree.h"
+#include "bucket_dast.h"
+#include "btree.h"
+#include "treap.h"
+#include "avl_tree.h"
+#include "skip_list.h"
+#include "sorted_vector.h"
+using namespace std;
+
+namespace zoo {
+
+// Every structure in the zoo exposes the interface of btree::BTree:
+//     void insert(int key);
+//     const int *lower_bound(const int &key);  // nullptr if there is none
+//     void clear();
+// so a benchmark can time them all through the same template. Trees that
+// return nodes from lower_bound are wrapped by NodeTree.
+
+// Adapter for trees whose lower_bound returns a node pointer
+template <typename Tree>
+struct NodeTree {
+    Tree tree;
+
+    void insert(int key) {
+        tree.insert(key);
+    }
+
+    const int *lower_bound(const int &key) {
+        auto *x = tree.lower_bound(key);
+        return x ? &x->key : nullptr;
+    }
+
+    void clear() {
+        tree.clear();
+    }
+};
+
+// Red-black tree baseline: libstdc++'s std::multiset, so that duplicate
+// keys are kept like in the other trees
+struct RedBlackTree {
+    multiset<int> keys;
+
+    void insert(int key) {
+        keys.insert(key);
+    }
+
+    const int *lower_bound(const int &key) const {
+        auto it = keys.lower_bound(key);
+        return it == keys.end() ? nullptr : &*it;
+    }
+
+    void clear() {
+        keys.clear();
+    }
+};
+
+using DepthAwareSplayTree = NodeTree<dast::DepthAwareSplayTree>;
+using SplayTree = NodeTree<ost::SplayTree>;
+using BucketDAST = bucket_dast::DepthAwareSplayTree<>;
+using BTree = btree::BTree;
+using Treap = treap::Treap;
+using AVLTree = avl::AVLTree;
+using SkipList = skip_list::SkipList;
+using SortedVector = sorted_vector::SortedVector;
+
+}
+#endif
@@ -0,0 +1,166 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <bits/stdc++.h>
+#include "simd_search.h"
+using namespace std;
+
+namespace btree {
+
+// Maximum number of keys held by a node before it splits
+constexpr int ORDER = 32;
+
+// Node structure shared by leaves and inner nodes. Nodes may hold one extra
+// key while an insert is in progress, after which they are split.
+struct Node {
+    bool leaf;
+    int count = 0;
+    int keys[ORDER + 1];
+
+    explicit Node(bool is_leaf) : leaf(is_leaf) {}
+
+    // Number of keys <= the given key
+    int upper_index(int key) const {
+        return simd::count_less_equal(keys, count, key);
+    }
+
+    // Number of keys < the given key
+    int lower_index(int key) const {
+        return simd::count_less(keys, count, key);
+    }
+};
+
+// Leaves hold the keys and are chained in key order
+struct Leaf : Node {
+    Leaf *next = nullptr;
+
+    Leaf() : Node(true) {}
+};
+
+// Inner nodes hold separators: keys[i] is the smallest key under child[i + 1]
+struct Inner : Node {
+    Node *child[ORDER + 2];
+
+    Inner() : Node(false) {}
+};
+
+// B+-tree baseline for comparative benchmarks
+struct BTree {
+    int size = 0;
+    Node *root = nullptr;
+
+    // Insert into the subtree, returning the new right sibling if the node
+    // split, with its separator stored in up
+    Node *insert(Node *x, int key, int &up) {
+        int index = x->upper_index(key);
+
+        if (x->leaf) {
+            memmove(x->keys + index + 1, x->keys + index, (x->count - index) * sizeof(int));
+            x->keys[index] = key;
+            x->count++;
+
+            if (x->count <= ORDER)
+                return nullptr;
+
+            Leaf *left = static_cast<Leaf *>(x);
+            Leaf *right = new Leaf();
+            int half = left->count / 2;
+            right->count = left->count - half;
+            memcpy(right->keys, left->keys + half, right->count * sizeof(int));
+            left->count = half;
+            right->next = left->next;
+            left->next = right;
+            up = right->keys[0];
+            return right;
+        }
+
+        Inner *inner = static_cast<Inner *>(x);
+        int separator;
+        Node *sibling = insert(inner->child[index], key, separator);
+        if (sibling == nullptr)
+            return nullptr;
+
+        memmove(inner->keys + index + 1, inner->keys + index, (inner->count - index) * sizeof(int));
+        memmove(inner->child + index + 2, inner->child + index + 1, (inner->count - index) * sizeof(Node *));
+        inner->keys[index] = separator;
+        inner->child[index + 1] = sibling;
+        inner->count++;
+
+        if (inner->count <= ORDER)
+            return nullptr;
+
+        Inner *right = new Inner();
+        int mid = inner->count / 2;
+        up = inner->keys[mid];
+        right->count = inner->count - mid - 1;
+        memcpy(right->keys, inner->keys + mid + 1, right->count * sizeof(int));
+        memcpy(right->child, inner->child + mid + 1, (right->count + 1) * sizeof(Node *));
+        inner->count = mid;
+        return right;
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+
+        if (root == nullptr)
+            root = new Leaf();
+
+        int up;
+        Node *sibling = insert(root, key, up);
+        if (sibling) {
+            Inner *new_root = new Inner();
+            new_root->count = 1;
+            new_root->keys[0] = up;
+            new_root->child[0] = root;
+            new_root->child[1] = sibling;
+            root = new_root;
+        }
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) const {
+        if (root == nullptr) return nullptr;
+
+        Node *current = root;
+        while (!current->leaf)
+            current = static_cast<Inner *>(current)->child[current->lower_index(key)];
+
+        Leaf *leaf = static_cast<Leaf *>(current);
+        int index = leaf->lower_index(key);
+        if (index == leaf->count) {
+            // Equal keys may continue in the next leaf
+            leaf = leaf->next;
+            index = 0;
+        }
+
+        return leaf ? leaf->keys + index : nullptr;
+    }
+
+    void destroy(Node *x) {
+        if (x->leaf) {
+            delete static_cast<Leaf *>(x);
+            return;
+        }
+
+        Inner *inner = static_cast<Inner *>(x);
+        for (int i = 0; i <= inner->count; i++)
+            destroy(inner->child[i]);
+        delete inner;
+    }
+
+    // Clear the entire tree
+    void clear() {
+        if (root) destroy(root);
+        root = nullptr;
+        size = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~BTree() {
+        clear();
+    }
+};
+
+}
+#endif
@@ -0,0 +1,303 @@
+#ifndef BUCKET_DAST_H
+#define BUCKET_DAST_H
+
+#include <bits/stdc++.h>
+#include "node_arena.h"
+#include "simd_search.h"
+using namespace std;
+
+namespace bucket_dast {
+
+// Node structure holding a sorted block of up to B keys. Every key in the
+// left subtree is <= keys[0] and every key in the right subtree is
+// >= keys[count - 1].
+template <int B>
+struct alignas(64) Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    int count = 0;
+    int keys[B];
+
+    // Set a child node and update its parent pointer
+    void set_child(int index, Node *child_node) {
+        child[index] = child_node;
+        if (child_node)
+            child_node->parent = this;
+    }
+
+    // Determine the index of this node relative to its parent
+    int parent_index() const {
+        return parent == nullptr ? -1 : int(this == parent->child[1]);
+    }
+
+    // Position of the first key >= the given key inside the bucket
+    int lower_index(int key) const {
+        return simd::count_less(keys, count, key);
+    }
+
+    // Position after the last key <= the given key inside the bucket
+    int upper_index(int key) const {
+        return simd::count_less_equal(keys, count, key);
+    }
+
+    void insert_at(int index, int key) {
+        memmove(keys + index + 1, keys + index, (count - index) * sizeof(int));
+        keys[index] = key;
+        count++;
+    }
+
+    void erase_at(int index) {
+        memmove(keys + index, keys + index + 1, (count - index - 1) * sizeof(int));
+        count--;
+    }
+};
+
+// Depth-aware splay tree over sorted key buckets. The splay rule operates on
+// bucket nodes, so the threshold is derived from the number of buckets.
+template <int B = 24>
+struct DepthAwareSplayTree {
+    using Node = bucket_dast::Node<B>;
+
+    int size = 0;
+    int bucket_count = 0;
+    int threshold = 0;
+
+    int get_depth_threshold() {
+        return floor(1.6 * log2(max(bucket_count, 1)));
+    }
+
+    Node *root = nullptr;
+    arena::NodeArena<Node> nodes;
+
+    // Set a new root for the tree
+    Node *set_root(Node *x) {
+        if (x)
+            x->parent = nullptr;
+        return root = x;
+    }
+
+    // Perform a single rotation
+    void rotate_up(Node *x) {
+        Node *p = x->parent;
+        Node *gp = p->parent;
+        int index = x->parent_index();
+
+        if (gp) {
+            gp->set_child(p->parent_index(), x);
+        } else {
+            set_root(x);
+        }
+
+        p->set_child(index, x->child[!index]);
+        x->set_child(!index, p);
+    }
+
+    // Splay operation to move a node to the root
+    void splay(Node *x) {
+        while (x != root) {
+            if (x->parent != root)
+                rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
+            rotate_up(x);
+        }
+    }
+
+    // In-order successor bucket
+    Node *next(Node *x) {
+        if (x->child[1]) {
+            x = x->child[1];
+            while (x->child[0])
+                x = x->child[0];
+            return x;
+        }
+
+        while (x->parent_index() == 1)
+            x = x->parent;
+        return x->parent;
+    }
+
+    Node *new_bucket() {
+        bucket_count++;
+        threshold = get_depth_threshold();
+        return nodes.allocate();
+    }
+
+    // Move the upper half of a full bucket into a new successor bucket
+    Node *split(Node *x) {
+        Node *y = new_bucket();
+        int half = x->count / 2;
+        y->count = x->count - half;
+        memcpy(y->keys, x->keys + half, y->count * sizeof(int));
+        x->count = half;
+
+        if (x->child[1] == nullptr) {
+            x->set_child(1, y);
+        } else {
+            Node *leftmost = x->child[1];
+            while (leftmost->child[0])
+                leftmost = leftmost->child[0];
+            leftmost->set_child(0, y);
+        }
+
+        return y;
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+
+        if (root == nullptr) {
+            Node *x = new_bucket();
+            x->keys[x->count++] = key;
+            set_root(x);
+            return;
+        }
+
+        // Find the bucket whose key range contains the key, or the last
+        // bucket visited when the key falls between two buckets
+        Node *current = root;
+        Node *target = nullptr;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+            target = current;
+
+            if (key < current->keys[0]) {
+                current = current->child[0];
+            } else if (current->keys[current->count - 1] < key) {
+                current = current->child[1];
+            } else {
+                break;
+            }
+        }
+
+        int index = target->upper_index(key);
+        Node *x = target;
+
+        if (x->count == B) {
+            Node *y = split(x);
+            if (index > x->count) {
+                index -= x->count;
+                x = y;
+            }
+        }
+
+        x->insert_at(index, key);
+
+        if (depth >= threshold)
+            splay(target);
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) {
+        Node *current = root;
+        Node *answer = nullptr;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+
+            if (current->keys[current->count - 1] < key) {
+                current = current->child[1];
+            } else {
+                answer = current;
+                if (current->keys[0] < key)
+                    break; // The answer lies inside this bucket
+                current = current->child[0];
+            }
+        }
+
+        if (answer == nullptr) return nullptr;
+        if (depth >= threshold) splay(answer);
+        return answer->keys + answer->lower_index(key);
+    }
+
+    // Unlink an empty or merged-away bucket from the tree
+    void remove_node(Node *x) {
+        bucket_count--;
+        threshold = get_depth_threshold();
+        splay(x); // Bring x to the root
+
+        if (x->child[0]) x->child[0]->parent = nullptr;
+        if (x->child[1]) x->child[1]->parent = nullptr;
+
+        Node *left_subtree = x->child[0];
+        Node *right_subtree = x->child[1];
+
+        nodes.deallocate(x); // Free memory for the node
+
+        if (!left_subtree) {
+            set_root(right_subtree);
+        } else {
+            set_root(left_subtree);
+            Node *max_left = left_subtree;
+            while (max_left->child[1]) {
+                max_left = max_left->child[1];
+            }
+            splay(max_left); // Bring max of left subtree to the root
+            max_left->set_child(1, right_subtree);
+            set_root(max_left);
+        }
+    }
+
+    // Remove one occurrence of a key, returning whether it was present
+    bool remove(int key) {
+        Node *current = root;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+
+            if (key < current->keys[0]) {
+                current = current->child[0];
+            } else if (current->keys[current->count - 1] < key) {
+                current = current->child[1];
+            } else {
+                break;
+            }
+        }
+
+        if (current == nullptr) return false;
+        int index = current->lower_index(key);
+        if (current->keys[index] != key) return false;
+
+        size--;
+        current->erase_at(index);
+
+        if (current->count == 0) {
+            remove_node(current);
+            return true;
+        }
+
+        // Merge an underfull bucket with its successor
+        if (current->count < B / 4) {
+            Node *successor = next(current);
+            if (successor && current->count + successor->count <= B * 3 / 4) {
+                memcpy(current->keys + current->count, successor->keys, successor->count * sizeof(int));
+                current->count += successor->count;
+                remove_node(successor);
+                return true;
+            }
+        }
+
+        if (depth >= threshold)
+            splay(current);
+        return true;
+    }
+
+    // Clear the entire tree
+    void clear() {
+        nodes.release();
+        root = nullptr;
+        size = 0;
+        bucket_count = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~DepthAwareSplayTree() {
+        clear();
+    }
+};
+
+}
+#endif
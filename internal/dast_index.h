@@ -2,6 +2,8 @@
 #define DAST_INDEX_H
 
 #include <bits/stdc++.h>
+#include "memory_usage.h"
+#include "splay_policy.h"
 using namespace std;
 
 namespace dast_index {
@@ -40,13 +42,17 @@ struct Node {
     }
 };
 
-struct DepthAwareSplayTree {
-    int size = 0;
-    int threshold = 0;
+// SplayPolicy decides which accesses restructure the tree (see splay_policy.h).
+// NodeType lets an implicit-key tree reuse the rotation, splay, split and
+// concat code here with its own node (dast_sequence and euler_tour do); it
+// needs parent, child, size, set_child, parent_index and join, and the
+// key-based operations need key.
+template <typename SplayPolicy = splay_policy::LogDepth<>, typename NodeType = Node>
+struct BasicDepthAwareSplayTree {
+    using Node = NodeType;
 
-    int get_depth_threshold() {
-        return floor(1.6 * log2(size));
-    }
+    int size = 0;
+    SplayPolicy policy;
 
     Node *root = nullptr;
 
@@ -77,10 +83,10 @@ struct DepthAwareSplayTree {
         p->join();
     }
 
-    // Splay operation to move a node to the root
-    void splay(Node *x) {
-        while (x != root) {
-            if (x->parent != root)
+    // Splay x until its parent is goal (the root when goal is null)
+    void splay(Node *x, Node *goal = nullptr) {
+        while (x->parent != goal) {
+            if (x->parent->parent != goal)
                 rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
             rotate_up(x);
         }
@@ -88,11 +94,77 @@ struct DepthAwareSplayTree {
         x->join();
     }
 
+    // Node-addressed sequence operations: the sequence is the subtree that
+    // holds x, up to its root, so several sequences can share one tree
+    // object, as the tours of an Euler-tour forest do; root then follows
+    // whichever sequence was splayed last.
+
+    // Root of the sequence holding x, without restructuring; depth receives
+    // the depth of x (root = 1)
+    static Node *find_root(Node *x, int &depth) {
+        depth = 1;
+        while (x->parent) {
+            x = x->parent;
+            depth++;
+        }
+        return x;
+    }
+
+    // Detach everything before x; returns that part's root and leaves x
+    // as the root of the rest
+    Node *split_before(Node *x) {
+        splay(x);
+        Node *left = x->child[0];
+        x->child[0] = nullptr;
+        if (left) left->parent = nullptr;
+        x->join();
+        return left;
+    }
+
+    // Detach everything after x; returns that part's root and leaves x
+    // as the root of the rest
+    Node *split_after(Node *x) {
+        splay(x);
+        Node *right = x->child[1];
+        x->child[1] = nullptr;
+        if (right) right->parent = nullptr;
+        x->join();
+        return right;
+    }
+
+    // Append sequence b to sequence a, given any nodes of them (or null);
+    // returns the root of the result. b is hung below the last node of a,
+    // which is splayed only when it is deep.
+    Node *concat(Node *a, Node *b) {
+        int depth;
+        if (a) a = find_root(a, depth);
+        if (b) b = find_root(b, depth);
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+
+        Node *last = a;
+        depth = 1;
+        while (last->child[1]) {
+            last = last->child[1];
+            depth++;
+        }
+
+        last->set_child(1, b);
+        for (Node *node = last; node != nullptr; node = node->parent)
+            node->join();
+
+        if (policy.should_splay(depth, last)) {
+            splay(last);
+            return last;
+        }
+        return a;
+    }
+
     // Insert a key into the tree
     void insert(int key) {
         size++;
 
-        threshold = get_depth_threshold();
+        policy.resize(size);
         static Node *x;
         x = new Node();
         x->key = key;
@@ -105,7 +177,8 @@ struct DepthAwareSplayTree {
         static Node *current, *previous;
         current = root;
         previous = nullptr;
-        static int depth = 0;
+        static int depth;
+        depth = 0;
 
         while (current != nullptr) {
             depth++;
@@ -115,7 +188,7 @@ struct DepthAwareSplayTree {
 
         previous->set_child(int(previous->key < x->key), x);
 
-        if (depth >= threshold)
+        if (policy.should_splay(depth, x))
             splay(x);
 
         for (Node *node = x; node != nullptr; node = node->parent)
@@ -140,7 +213,7 @@ struct DepthAwareSplayTree {
             }
         }
 
-        if (depth >= threshold) splay(answer);
+        if (answer && policy.should_splay(depth, answer)) splay(answer);
         return answer;
     }
 
@@ -159,7 +232,7 @@ struct DepthAwareSplayTree {
             depth++;
 
             if (index == left_size) {
-                if (depth >= threshold) {
+                if (policy.should_splay(depth, current)) {
                     splay(current);
                 }
 
@@ -177,9 +250,27 @@ struct DepthAwareSplayTree {
         assert(false);
     }
 
+    // Number of keys < the given key, counted on the way down, since the
+    // lower bound is only at the root when the access splayed it
     int order_of_key(const int &key) {
-        auto node = lower_bound(key);
-        return get_size(node->child[0]);
+        Node *current = root;
+        Node *answer = nullptr;
+        int order = 0, depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+
+            if (current->key < key) {
+                order += get_size(current->child[0]) + 1;
+                current = current->child[1];
+            } else {
+                answer = current;
+                current = current->child[0];
+            }
+        }
+
+        if (answer && policy.should_splay(depth, answer)) splay(answer);
+        return order;
     }
 
     // Remove a specific node
@@ -187,7 +278,7 @@ struct DepthAwareSplayTree {
         if (x == nullptr) return;
 
         size--;
-        threshold = get_depth_threshold();
+        policy.resize(size);
         splay(x); // Bring x to the root
 
         if (x->child[0]) x->child[0]->parent = nullptr;
@@ -196,21 +287,33 @@ struct DepthAwareSplayTree {
         Node *left_subtree = x->child[0];
         Node *right_subtree = x->child[1];
 
+        x->child[0] = x->child[1] = nullptr;
         delete x; // Free memory for the node
 
         if (!left_subtree) {
             set_root(right_subtree);
         } else {
+            set_root(left_subtree);
             Node *max_left = left_subtree;
             while (max_left->child[1]) {
                 max_left = max_left->child[1];
             }
             splay(max_left); // Bring max of left subtree to the root
             max_left->set_child(1, right_subtree);
+            max_left->join();
             set_root(max_left);
         }
     }
 
+    // Heap bytes held by the tree; every node is a separate allocation, so
+    // there is no slack beyond the allocator's own overhead
+    memory::Usage memory_usage() const {
+        memory::Usage usage;
+        usage.nodes = size * sizeof(Node);
+        usage.augmentation = size * sizeof(Node::size);
+        return usage;
+    }
+
     // Clear the entire tree
     void clear() {
         delete root;
@@ -219,10 +322,12 @@ struct DepthAwareSplayTree {
     }
 
     // Destructor to clear the tree when it goes out of scope
-    ~DepthAwareSplayTree() {
+    ~BasicDepthAwareSplayTree() {
         clear();
     }
 };
 
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
 }
 #endif
\ No newline at end of file
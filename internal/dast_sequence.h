@@ -0,0 +1,323 @@
+#ifndef DAST_SEQUENCE_H
+#define DAST_SEQUENCE_H
+
+#include <bits/stdc++.h>
+#include "dast_index.h"
+using namespace std;
+
+namespace dast_sequence {
+
+// Node structure for the implicit-key Splay Tree: a node's position is the
+// size of everything to its left, so no key is stored
+struct Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    int value;
+    int size = 1;
+    bool reversed = false; // Pending reversal of this subtree's children
+
+    friend int get_size(Node *x) {
+        return x == nullptr ? 0 : x->size;
+    }
+
+    // Set a child node and update its parent pointer
+    void set_child(int index, Node *child_node) {
+        child[index] = child_node;
+        if (child_node)
+            child_node->parent = this;
+    }
+
+    // Determine the index of this node relative to its parent
+    int parent_index() const {
+        return parent == nullptr ? -1 : int(this == parent->child[1]);
+    }
+
+    void join() {
+        size = get_size(child[0]) + get_size(child[1]) + 1;
+    }
+
+    // Apply a pending reversal to the children
+    void push() {
+        if (!reversed) return;
+        swap(child[0], child[1]);
+        if (child[0]) child[0]->reversed ^= true;
+        if (child[1]) child[1]->reversed ^= true;
+        reversed = false;
+    }
+
+    ~Node() {
+        // Recursively delete children
+        delete child[0];
+        delete child[1];
+    }
+};
+
+// Sequence container (rope) over an implicit-key depth-aware splay tree.
+// Positional accesses and edits splay only when the depth rule fires, so
+// repeated edits near a cursor do not rotate the whole path; split, concat
+// and reverse bring their boundary nodes to the root.
+//
+// The tree itself is dast_index's, which keeps the size augmentation and
+// the rotation and splay code; only the positional operations, which must
+// push pending reversals on the way down, live here. The key-based
+// operations of dast_index are not exposed.
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSequence : private dast_index::BasicDepthAwareSplayTree<SplayPolicy, Node> {
+    using Tree = dast_index::BasicDepthAwareSplayTree<SplayPolicy, Node>;
+
+    using Tree::size;
+    using Tree::policy;
+    using Tree::root;
+    using Tree::set_root;
+    using Tree::clear;
+
+    // Rotations and splays require the path to x to be pushed already,
+    // which every descent here does
+    using Tree::rotate_up;
+    using Tree::splay;
+
+    BasicDepthAwareSequence() = default;
+    BasicDepthAwareSequence(const BasicDepthAwareSequence &) = delete;
+    BasicDepthAwareSequence &operator=(const BasicDepthAwareSequence &) = delete;
+
+    BasicDepthAwareSequence(BasicDepthAwareSequence &&other) {
+        *this = std::move(other);
+    }
+
+    BasicDepthAwareSequence &operator=(BasicDepthAwareSequence &&other) {
+        if (this != &other) {
+            clear();
+            swap(root, other.root);
+            swap(size, other.size);
+            policy.resize(size);
+            other.policy.resize(0);
+        }
+        return *this;
+    }
+
+    // Find the node at the given position, pushing reversals along the way;
+    // depth receives its depth (root = 1)
+    Node *find(int index, int &depth) {
+        Node *current = root;
+        depth = 0;
+
+        while (current != nullptr) {
+            current->push();
+            int left_size = get_size(current->child[0]);
+            depth++;
+
+            if (index == left_size)
+                return current;
+
+            if (index < left_size) {
+                current = current->child[0];
+            } else {
+                current = current->child[1];
+                index -= left_size + 1;
+            }
+        }
+
+        assert(false);
+        return nullptr;
+    }
+
+    // Value at the given position
+    int at(int index) {
+        assert(0 <= index && index < size);
+        int depth;
+        Node *x = find(index, depth);
+        if (policy.should_splay(depth, x))
+            splay(x);
+        return x->value;
+    }
+
+    // Insert a value so that it ends up at the given position
+    void insert_at(int index, int value) {
+        assert(0 <= index && index <= size);
+        size++;
+        policy.resize(size);
+
+        Node *x = new Node();
+        x->value = value;
+
+        if (root == nullptr) {
+            set_root(x);
+            return;
+        }
+
+        // Descend to the empty slot just before the element now at index
+        Node *current = root, *previous = nullptr;
+        int side = 0, depth = 0;
+
+        while (current != nullptr) {
+            current->push();
+            depth++;
+            previous = current;
+            int left_size = get_size(current->child[0]);
+
+            side = int(index > left_size);
+            if (side)
+                index -= left_size + 1;
+            current = current->child[side];
+        }
+
+        previous->set_child(side, x);
+
+        if (policy.should_splay(depth, x))
+            splay(x);
+
+        for (Node *node = x->parent; node != nullptr; node = node->parent)
+            node->join();
+    }
+
+    void push_back(int value) {
+        insert_at(size, value);
+    }
+
+    // Remove the element at the given position. Nodes with at most one child
+    // are spliced out in place; otherwise the in-order successor's value is
+    // moved up and the successor is spliced out instead.
+    void erase_at(int index) {
+        assert(0 <= index && index < size);
+        size--;
+        policy.resize(size);
+
+        int depth;
+        Node *x = find(index, depth);
+
+        if (x->child[0] && x->child[1]) {
+            Node *successor = x->child[1];
+            successor->push();
+            depth++;
+            while (successor->child[0]) {
+                successor = successor->child[0];
+                successor->push();
+                depth++;
+            }
+            x->value = successor->value;
+            x = successor;
+        }
+
+        Node *replacement = x->child[0] ? x->child[0] : x->child[1];
+        Node *parent = x->parent;
+
+        if (parent) {
+            parent->set_child(x->parent_index(), replacement);
+        } else {
+            set_root(replacement);
+        }
+
+        x->child[0] = x->child[1] = nullptr;
+        delete x;
+
+        for (Node *node = parent; node != nullptr; node = node->parent)
+            node->join();
+
+        if (parent && policy.should_splay(depth - 1, parent))
+            splay(parent);
+    }
+
+    // Move the elements at positions [index, size) into a new sequence
+    BasicDepthAwareSequence split_at(int index) {
+        assert(0 <= index && index <= size);
+        BasicDepthAwareSequence tail;
+        if (index == size)
+            return tail;
+
+        int depth;
+        Node *x = find(index, depth);
+        splay(x);
+
+        Node *left = x->child[0];
+        x->child[0] = nullptr;
+        x->join();
+        set_root(left);
+
+        tail.set_root(x);
+        tail.size = size - index;
+        tail.policy.resize(tail.size);
+        size = index;
+        policy.resize(size);
+        return tail;
+    }
+
+    // Append all elements of other, leaving other empty
+    void concat(BasicDepthAwareSequence &other) {
+        if (other.root == nullptr)
+            return;
+
+        if (root == nullptr) {
+            *this = std::move(other);
+            return;
+        }
+
+        int depth;
+        Node *last = find(size - 1, depth);
+        splay(last);
+        last->set_child(1, other.root);
+        last->join();
+
+        size += other.size;
+        policy.resize(size);
+        other.root = nullptr;
+        other.size = 0;
+        other.policy.resize(0);
+    }
+
+    // Reverse the elements at positions [left, right)
+    void reverse(int left, int right) {
+        assert(0 <= left && left <= right && right <= size);
+        if (right - left < 2)
+            return;
+
+        // Isolate the range as a single subtree below its two neighbours
+        int depth;
+        Node *range;
+        if (right < size) {
+            Node *after = find(right, depth);
+            splay(after);
+            if (left > 0) {
+                Node *before = find(left - 1, depth);
+                splay(before, after);
+                range = before->child[1];
+            } else {
+                range = after->child[0];
+            }
+        } else if (left > 0) {
+            Node *before = find(left - 1, depth);
+            splay(before);
+            range = before->child[1];
+        } else {
+            range = root;
+        }
+
+        range->reversed ^= true;
+    }
+
+    // Copy the sequence out in order
+    vector<int> to_vector() {
+        vector<int> values;
+        values.reserve(size);
+        vector<Node *> stack;
+        Node *current = root;
+
+        while (current != nullptr || !stack.empty()) {
+            while (current != nullptr) {
+                current->push();
+                stack.push_back(current);
+                current = current->child[0];
+            }
+            current = stack.back();
+            stack.pop_back();
+            values.push_back(current->value);
+            current = current->child[1];
+        }
+
+        return values;
+    }
+};
+
+using DepthAwareSequence = BasicDepthAwareSequence<>;
+
+}
+#endif
@@ -2,6 +2,9 @@
 #define DEPTH_AWARE_SPLAY_TREE_H
 
 #include <bits/stdc++.h>
+#include "memory_usage.h"
+#include "node_arena.h"
+#include "splay_policy.h"
 using namespace std;
 
 namespace dast {
@@ -12,6 +15,15 @@ struct Node {
     Node *child[2] = {nullptr, nullptr};
     int key;
 
+    // Access counter state for splay_policy::Frequency; fits in the padding
+    // after key, so the node stays 32 bytes
+    uint8_t hits = 0;
+    uint8_t epoch = 0;
+
+    // Bumped by the arena each time the node is freed, so that caches
+    // holding a node pointer can tell when it was reused
+    uint16_t generation = 0;
+
     // Set a child node and update its parent pointer
     void set_child(int index, Node *child_node) {
         child[index] = child_node;
@@ -23,23 +35,62 @@ struct Node {
     int parent_index() const {
         return parent == nullptr ? -1 : int(this == parent->child[1]);
     }
-
-    ~Node() {
-        // Recursively delete children
-        delete child[0];
-        delete child[1];
-    }
 };
 
-struct DepthAwareSplayTree {
-    int size = 0;
-    int threshold = 0;
+// Reference to a node that can be kept across updates and checked before
+// use: it stays valid until the node is removed or the tree is cleared,
+// including across compact() and automatic relayouts, which move the node,
+// and meld(), after which the tree melded into answers for it. It is
+// resolved through the arena's slot table without touching freed memory,
+// and rejected by every other tree.
+using Handle = arena::Handle;
+
+// Next value of the process-wide layout sequence, which tells caches of
+// Node pointers that the nodes moved
+inline uint32_t next_layout_generation() {
+    static atomic<uint32_t> counter{0};
+    return ++counter;
+}
 
-    int get_depth_threshold() {
-        return floor(1.6 * log2(size));
-    }
+// SplayPolicy decides which accesses restructure the tree (see splay_policy.h)
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    int size = 0;
+    SplayPolicy policy;
 
     Node *root = nullptr;
+    arena::NodeArena<Node> nodes;
+
+    // First and last node in key order, kept up to date by every update so
+    // that the tree can serve as a priority queue
+    Node *min_node = nullptr;
+    Node *max_node = nullptr;
+
+    // Number of top levels that compact() lays out breadth-first
+    size_t compact_bfs_levels = 12;
+
+    // Automatic relayout: every compact_check_interval lookups, compact the
+    // tree if it was restructured since the last relayout and fewer than
+    // compact_splay_rate of those lookups splayed (0 disables the check)
+    int compact_check_interval = 0;
+    double compact_splay_rate = 0.01;
+    int lookups_since_check = 0;
+    int splays_since_check = 0;
+    bool layout_dirty = false;
+
+    // Opt-in software prefetching: lower_bound prefetches both children of
+    // each node before comparing against it, and splay prefetches the path
+    // nodes the next rotations will touch
+    bool prefetch = false;
+
+    // Replaced whenever nodes are relocated or freed wholesale, which
+    // invalidates every Node pointer (but not Handles)
+    uint32_t layout_generation = next_layout_generation();
+
+    // Partial splay: when positive, an access that exceeds the threshold
+    // only splays the node until its depth drops below this fraction of the
+    // threshold, so the established hot top of the tree stays in place
+    double partial_splay_fraction = 0;
 
     // Set a new root for the tree
     Node *set_root(Node *x) {
@@ -50,11 +101,9 @@ struct DepthAwareSplayTree {
 
     // Perform a single rotation
     void rotate_up(Node *x) {
-        static Node *p, *gp;
-        p = x->parent;
-        gp = p->parent;
-        static int index;
-        index = x->parent_index();
+        Node *p = x->parent;
+        Node *gp = p->parent;
+        int index = x->parent_index();
 
         if (gp) {
             gp->set_child(p->parent_index(), x);
@@ -66,34 +115,66 @@ struct DepthAwareSplayTree {
         x->set_child(!index, p);
     }
 
-    // Splay operation to move a node to the root
-    void splay(Node *x) {
-        while (x != root) {
-            if (x->parent != root)
+    // Splay operation to move a node to the root, or only until its depth
+    // (root = 1) drops below target_depth when one is given
+    void splay(Node *x, int depth = 0, int target_depth = INT_MIN) {
+        layout_dirty = true;
+        while (x != root && depth >= target_depth) {
+            if (prefetch) {
+                // The next double rotation links x under its current
+                // great-grandparent, whose parent is touched right after
+                Node *ahead = x->parent->parent;
+                if (ahead && (ahead = ahead->parent))
+                    __builtin_prefetch(ahead->parent);
+            }
+
+            if (x->parent != root) {
                 rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
+                depth--;
+            }
             rotate_up(x);
+            depth--;
         }
     }
 
-    // Insert a key into the tree
-    void insert(int key) {
+    // Restructure after an access that went past the depth threshold
+    void splay_deep(Node *x, int depth) {
+        if (partial_splay_fraction > 0)
+            splay(x, depth, std::max(1, int(partial_splay_fraction * policy.threshold)));
+        else
+            splay(x);
+    }
+
+    // Insert a key into the tree and return its node
+    Node *insert(int key) {
         size++;
 
-        threshold = get_depth_threshold();
-        static Node *x;
-        x = new Node();
+        policy.resize(size);
+        Node *x = nodes.allocate();
         x->key = key;
+        layout_dirty = true;
+
+        link(x);
+        return x;
+    }
+
+    // Attach a detached node at its key's position
+    void link(Node *x) {
+        x->child[0] = x->child[1] = nullptr;
 
         if (root == nullptr) {
             set_root(x);
+            min_node = max_node = x;
             return;
         }
 
-        static Node *current, *previous;
-        current = root;
-        previous = nullptr;
-        static int depth;
-        depth = 0;
+        // Equal keys go left, so a new duplicate of the minimum becomes the
+        // minimum while a duplicate of the maximum does not
+        if (x->key <= min_node->key) min_node = x;
+        if (x->key > max_node->key) max_node = x;
+
+        Node *current = root, *previous = nullptr;
+        int depth = 0;
 
         while (current != nullptr) {
             depth++;
@@ -103,38 +184,154 @@ struct DepthAwareSplayTree {
 
         previous->set_child(int(previous->key < x->key), x);
 
-        if (depth >= threshold)
-            splay(x);
+        if (policy.should_splay(depth, x))
+            splay_deep(x, depth + 1);
     }
 
-    // Find the node with the smallest key >= the given key
+    // Find the node with the smallest key >= the given key. With automatic
+    // relayout enabled, any lookup may move every node, so Node pointers
+    // from earlier calls must not be kept across it; keep a Handle instead.
     Node *lower_bound(const int &key) {
         Node *current;
         current = root;
         Node *answer = nullptr;answer = nullptr;
-        int depth = 0;
+        int depth = 0, answer_depth = 0;
 
         while (current != nullptr) {
             depth++;
 
+            if (prefetch) {
+                __builtin_prefetch(current->child[0]);
+                __builtin_prefetch(current->child[1]);
+            }
+
             if (current->key < key) {
                 current = current->child[1];
             } else {
                 answer = current;
+                answer_depth = depth;
                 current = current->child[0];
             }
         }
 
-        if (depth >= threshold) splay(answer);
+        bool splayed = answer && policy.should_splay(depth, answer);
+        if (splayed) splay_deep(answer, answer_depth);
+        if (compact_check_interval) answer = record_lookup(answer, splayed);
         return answer;
     }
 
+    // Count a lookup towards the automatic relayout check; returns where
+    // the looked-up node x lives afterwards, since a relayout moves it
+    Node *record_lookup(Node *x, bool splayed) {
+        splays_since_check += splayed;
+        if (++lookups_since_check < compact_check_interval)
+            return x;
+
+        if (layout_dirty && splays_since_check < compact_splay_rate * lookups_since_check)
+            x = compact(x);
+
+        lookups_since_check = 0;
+        splays_since_check = 0;
+        return x;
+    }
+
+    // Relocate every node into one fresh block so that descents touch nearby
+    // memory: the top compact_bfs_levels levels are stored breadth-first and
+    // each subtree below them is stored in depth-first (preorder) order.
+    // The tree shape is preserved, and Handles are carried over to the new
+    // addresses, but Node pointers obtained before the call are
+    // invalidated; the new address of the node follow, if one is given, is
+    // returned.
+    Node *compact(Node *follow = nullptr) {
+        layout_dirty = false;
+        if (root == nullptr) return follow;
+
+        vector<Node *> order, subtrees;
+        order.reserve(size);
+        order.push_back(root);
+
+        for (size_t level_begin = 0, level = 1; level_begin < order.size(); level++) {
+            size_t level_end = order.size();
+            for (size_t i = level_begin; i < level_end; i++) {
+                for (Node *c : order[i]->child) {
+                    if (c == nullptr) continue;
+                    if (level < compact_bfs_levels)
+                        order.push_back(c);
+                    else
+                        subtrees.push_back(c);
+                }
+            }
+            level_begin = level_end;
+        }
+
+        vector<Node *> stack;
+        for (Node *subtree : subtrees) {
+            stack.push_back(subtree);
+            while (!stack.empty()) {
+                Node *x = stack.back();
+                stack.pop_back();
+                order.push_back(x);
+                if (x->child[1]) stack.push_back(x->child[1]);
+                if (x->child[0]) stack.push_back(x->child[0]);
+            }
+        }
+
+        arena::NodeArena<Node> fresh;
+        fresh.reserve_block(order.size());
+        for (Node *x : order) {
+            Node *y = fresh.allocate();
+            *y = *x;
+            x->parent = y; // Leave a forwarding address in the old node
+        }
+
+        Node *block = fresh.blocks.back().nodes;
+        for (size_t i = 0; i < order.size(); i++) {
+            Node *y = block + i;
+            if (y->parent) y->parent = y->parent->parent;
+            if (y->child[0]) y->child[0] = y->child[0]->parent;
+            if (y->child[1]) y->child[1] = y->child[1]->parent;
+        }
+
+        nodes.forward_handles([](Node *x) { return x->parent; });
+        layout_generation = next_layout_generation();
+        root = root->parent;
+        min_node = min_node->parent;
+        max_node = max_node->parent;
+        if (follow) follow = follow->parent;
+        nodes.swap(fresh);
+        return follow;
+    }
+
     // Remove a specific node
     void remove(Node *x) {
         if (x == nullptr) return;
 
+        unlink(x);
+        nodes.deallocate(x); // Free memory for the node
+    }
+
+    // Handle to a node of this tree, or an empty handle for nullptr
+    Handle handle(Node *x) {
+        return nodes.handle(x);
+    }
+
+    // Node a handle refers to, or nullptr if it was removed since
+    Node *get(const Handle &h) const {
+        return nodes.get(h);
+    }
+
+    // Remove the node a handle refers to; returns false if it is stale
+    bool remove(const Handle &h) {
+        Node *x = get(h);
+        if (x == nullptr) return false;
+        remove(x);
+        return true;
+    }
+
+    // Detach a node from the tree without freeing it
+    void unlink(Node *x) {
         size--;
-        threshold = get_depth_threshold();
+        policy.resize(size);
         splay(x); // Bring x to the root
 
         if (x->child[0]) x->child[0]->parent = nullptr;
@@ -143,11 +340,15 @@ struct DepthAwareSplayTree {
         Node *left_subtree = x->child[0];
         Node *right_subtree = x->child[1];
 
-        delete x; // Free memory for the node
+        // At the root, the minimum has no left subtree and its successor is
+        // the leftmost node on the right; symmetrically for the maximum
+        if (x == min_node) min_node = extreme(right_subtree, 0);
+        if (x == max_node) max_node = extreme(left_subtree, 1);
 
         if (!left_subtree) {
             set_root(right_subtree);
         } else {
+            set_root(left_subtree);
             Node *max_left = left_subtree;
             while (max_left->child[1]) {
                 max_left = max_left->child[1];
@@ -158,18 +359,280 @@ struct DepthAwareSplayTree {
         }
     }
 
+    // Leftmost (side 0) or rightmost (side 1) node of a subtree
+    static Node *extreme(Node *x, int side) {
+        if (x == nullptr) return nullptr;
+        while (x->child[side]) x = x->child[side];
+        return x;
+    }
+
+    // Node with the smallest key, or nullptr if the tree is empty
+    Node *min() const {
+        return min_node;
+    }
+
+    // Node with the largest key, or nullptr if the tree is empty
+    Node *max() const {
+        return max_node;
+    }
+
+    // Remove the minimum and return its key; the tree must not be empty.
+    // Queue pops only touch the ends of the tree, so they never splay:
+    // the node is spliced out where it is and the depth rule is left to
+    // the inserts, which keep the paths to both ends short.
+    int pop_min() {
+        return pop_extreme(0);
+    }
+
+    // Remove the maximum and return its key; the tree must not be empty
+    int pop_max() {
+        return pop_extreme(1);
+    }
+
+    // Lower the key of a node, which stays valid; does nothing unless
+    // key < x->key
+    void decrease_key(Node *x, int key) {
+        if (!(key < x->key)) return;
+
+        // The minimum stays the minimum, so its key can change in place
+        if (x == min_node) {
+            x->key = key;
+            return;
+        }
+
+        unlink(x);
+        x->key = key;
+        size++;
+        policy.resize(size);
+        link(x);
+    }
+
+    // Move every key of other into this tree, leaving other empty. Nodes
+    // and their arena blocks are taken over rather than reallocated. When
+    // the key ranges are disjoint, one tree is attached below an end node
+    // of the other in O(log n) amortized. Otherwise a much smaller tree is
+    // linked in node by node, and two trees of similar size are cut into
+    // runs of keys that do not interleave with the other tree and the runs
+    // are joined, in O(k log n) amortized for k runs. Past sqrt(n) runs
+    // the rest of other is linked in node by node.
+    void meld(BasicDepthAwareSplayTree &other) {
+        if (&other == this || other.root == nullptr) return;
+
+        Node *other_root = other.root, *other_min = other.min_node, *other_max = other.max_node;
+        int other_size = other.size;
+        nodes.adopt(other.nodes);
+        other.root = other.min_node = other.max_node = nullptr;
+        other.size = 0;
+        other.layout_generation = next_layout_generation();
+        other.policy.resize(0);
+
+        int old_size = size;
+        size += other_size;
+        policy.resize(size);
+        layout_dirty = true;
+
+        if (root == nullptr) {
+            set_root(other_root);
+            min_node = other_min;
+            max_node = other_max;
+        } else if (max_node->key <= other_min->key) {
+            // Equal keys go left, so a tie still belongs on the right
+            splay(max_node);
+            root->set_child(1, other_root);
+            max_node = other_max;
+        } else if (other_max->key < min_node->key) {
+            splay(min_node);
+            root->set_child(0, other_root);
+            min_node = other_min;
+        } else if (double(std::min(old_size, other_size)) * log2(size) < size) {
+            // Overlapping, and one side is small enough to insert
+            Node *small_root = other_root;
+            if (old_size < other_size) {
+                small_root = root;
+                set_root(other_root);
+                min_node = other_min;
+                max_node = other_max;
+            }
+            vector<Node *> small;
+            flatten(small_root, small);
+            for (Node *x : small)
+                link(x);
+        } else {
+            other.set_root(other_root);
+            meld_runs(other);
+            other.root = nullptr;
+        }
+    }
+
+    // Meld two overlapping trees of similar size, taking equal keys from
+    // this tree first. Each step splits off the longest prefix of the tree
+    // with the smaller minimum that lies below the other tree's minimum,
+    // which a splay leaves as its boundary node with the prefix as its left
+    // subtree; the runs are then joined in order.
+    void meld_runs(BasicDepthAwareSplayTree &other) {
+        BasicDepthAwareSplayTree *trees[2] = {this, &other};
+        Node *mins[2] = {extreme(root, 0), extreme(other.root, 0)};
+        size_t max_runs = sqrt(size);  // Past this, cutting costs more than linking
+        vector<Node *> runs;  // Each the maximum of its run, with the rest below it on the left
+
+        while (mins[0] && mins[1] && runs.size() <= max_runs) {
+            int from = mins[1]->key < mins[0]->key;
+            BasicDepthAwareSplayTree &source = *trees[from];
+            int bound = mins[!from]->key;
+
+            // Last node with key <= bound in this tree, or < bound in other
+            Node *last = nullptr;
+            for (Node *current = source.root; current != nullptr;) {
+                if (current->key < bound || (from == 0 && current->key == bound)) {
+                    last = current;
+                    current = current->child[1];
+                } else {
+                    current = current->child[0];
+                }
+            }
+
+            source.splay(last);
+            source.set_root(last->child[1]);
+            last->child[1] = nullptr;
+            runs.push_back(last);
+            mins[from] = extreme(source.root, 0);
+        }
+
+        if (runs.size() > max_runs) {
+            // The trees interleave too finely for runs to pay off, so the
+            // rest of other is linked in node by node. Its keys arrive in
+            // order, each next to where the last splay left the previous
+            // one, and the runs cut so far go below the new minimum.
+            Node *prefix = join_runs(runs, 0, runs.size());
+            vector<Node *> rest;
+            flatten(other.root, rest);
+            other.root = nullptr;
+            min_node = extreme(root, 0);
+            max_node = extreme(root, 1);
+            for (Node *x : rest)
+                link(x);
+
+            if (root) {
+                splay(min_node);
+                root->set_child(0, prefix);
+            } else {
+                set_root(prefix);
+            }
+            min_node = extreme(root, 0);
+            max_node = extreme(root, 1);
+            return;
+        }
+
+        // The tree left over is the last run once its maximum is on top
+        BasicDepthAwareSplayTree &rest = mins[0] ? *this : other;
+        rest.splay(extreme(rest.root, 1));
+        runs.push_back(rest.root);
+
+        set_root(join_runs(runs, 0, runs.size()));
+        min_node = extreme(root, 0);
+        max_node = extreme(root, 1);
+    }
+
+    // Join runs[begin, end), in key order, into a tree of depth O(log k)
+    // in the runs: the middle run's maximum becomes the root, and the runs
+    // before it hang below the leftmost node of its own run
+    static Node *join_runs(const vector<Node *> &runs, size_t begin, size_t end) {
+        if (begin == end) return nullptr;
+        size_t middle = begin + (end - begin) / 2;
+        Node *x = runs[middle];
+
+        Node *left = join_runs(runs, begin, middle);
+        if (left)
+            (x->child[0] ? extreme(x->child[0], 0) : x)->set_child(0, left);
+        x->set_child(1, join_runs(runs, middle + 1, end));
+        return x;
+    }
+
+    // Append the nodes of a subtree in key order
+    static void flatten(Node *x, vector<Node *> &out) {
+        vector<Node *> stack;
+        while (x != nullptr || !stack.empty()) {
+            while (x != nullptr) {
+                stack.push_back(x);
+                x = x->child[0];
+            }
+            x = stack.back();
+            stack.pop_back();
+            out.push_back(x);
+            x = x->child[1];
+        }
+    }
+
+    // Link nodes[begin, end) into a balanced subtree and return its root
+    static Node *build(const vector<Node *> &nodes, size_t begin, size_t end) {
+        if (begin == end) return nullptr;
+        size_t middle = begin + (end - begin) / 2;
+        Node *x = nodes[middle];
+        x->set_child(0, build(nodes, begin, middle));
+        x->set_child(1, build(nodes, middle + 1, end));
+        return x;
+    }
+
+    // Splice out min_node (side 0) or max_node (side 1), which has no child
+    // on that side, and free it
+    int pop_extreme(int side) {
+        Node *x = side ? max_node : min_node;
+        int key = x->key;
+
+        size--;
+        policy.resize(size);
+        layout_dirty = true;
+
+        Node *p = x->parent, *c = x->child[!side];
+        if (p)
+            p->set_child(side, c);
+        else
+            set_root(c);
+
+        // The next node inward is the extreme of the spliced-in subtree, or
+        // else the parent
+        Node *next = c ? extreme(c, side) : p;
+        if (side)
+            max_node = next;
+        else
+            min_node = next;
+        if (size == 0)
+            min_node = max_node = nullptr;
+
+        nodes.deallocate(x);
+        return key;
+    }
+
+    // Heap bytes held by the tree; slack is arena space not holding a live
+    // node. The augmentation is the splay policy's per-node counters, when
+    // the policy uses them, the overhead is the generation that caches are
+    // checked against, and the tables are the slots behind handles.
+    memory::Usage memory_usage() const {
+        memory::Usage usage;
+        usage.nodes = nodes.live * sizeof(Node);
+        usage.slack = nodes.capacity_bytes() - usage.nodes;
+        if (splay_policy::uses_node_counters<SplayPolicy>::value)
+            usage.augmentation = nodes.live * (sizeof(Node::hits) + sizeof(Node::epoch));
+        usage.overhead = nodes.live * sizeof(Node::generation);
+        usage.tables = nodes.handle_bytes();
+        return usage;
+    }
+
     // Clear the entire tree
     void clear() {
-        delete root;
-        root = nullptr;
+        nodes.release();
+        layout_generation = next_layout_generation();
+        root = min_node = max_node = nullptr;
         size = 0;
     }
 
     // Destructor to clear the tree when it goes out of scope
-    ~DepthAwareSplayTree() {
+    ~BasicDepthAwareSplayTree() {
         clear();
     }
 };
 
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
 }
 #endif
\ No newline at end of file
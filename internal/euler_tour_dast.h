@@ -0,0 +1,269 @@
+#ifndef EULER_TOUR_DAST_H
+#define EULER_TOUR_DAST_H
+
+#include <bits/stdc++.h>
+#include "dast_index.h"
+#include "node_arena.h"
+using namespace std;
+
+namespace euler_tour {
+
+// Node of an Euler tour sequence: either the single occurrence of a vertex
+// or one direction of an edge (an arc). Keys are implicit, as in
+// dast_sequence: a node's position is the size of everything to its left.
+struct Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    int size = 1;        // Nodes in the subtree
+    int vertices = 0;    // Vertex nodes in the subtree
+    long long value = 0; // Vertex value; 0 for arcs
+    long long sum = 0;   // Sum of the vertex values in the subtree
+    bool is_vertex = false;
+
+    friend int get_size(Node *x) {
+        return x == nullptr ? 0 : x->size;
+    }
+
+    friend int get_vertices(Node *x) {
+        return x == nullptr ? 0 : x->vertices;
+    }
+
+    friend long long get_sum(Node *x) {
+        return x == nullptr ? 0LL : x->sum;
+    }
+
+    // Set a child node and update its parent pointer
+    void set_child(int index, Node *child_node) {
+        child[index] = child_node;
+        if (child_node)
+            child_node->parent = this;
+    }
+
+    // Determine the index of this node relative to its parent
+    int parent_index() const {
+        return parent == nullptr ? -1 : int(this == parent->child[1]);
+    }
+
+    void join() {
+        size = get_size(child[0]) + get_size(child[1]) + 1;
+        vertices = get_vertices(child[0]) + get_vertices(child[1]) + is_vertex;
+        sum = get_sum(child[0]) + get_sum(child[1]) + value;
+    }
+};
+
+// Euler-tour tree over the vertices 0 .. n - 1. Every tree of the forest is
+// stored as its Euler tour, a sequence holding each vertex once and each
+// edge as two arcs (u -> v after the subtree entered through it, v -> u
+// before), in an implicit-key splay tree. Linking and cutting split and
+// concatenate tours. Queries only walk from a node up to its sequence
+// root, and splay that node only when the walk reaches the depth
+// threshold of SplayPolicy, taking the total node count as the size.
+//
+// The splay code, and splitting and concatenating sequences by node, are
+// dast_index's, instantiated with the Node above; one tree object holds
+// every tour of the forest.
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicEulerTourTree : private dast_index::BasicDepthAwareSplayTree<SplayPolicy, Node> {
+    using Tree = dast_index::BasicDepthAwareSplayTree<SplayPolicy, Node>;
+
+    using Tree::policy;
+    using Tree::rotate_up;
+    using Tree::splay;
+
+    vector<Node> vertices;
+
+    explicit BasicEulerTourTree(int n) : vertices(n) {
+        for (Node &x : vertices) {
+            x.is_vertex = true;
+            x.join();
+        }
+        policy.resize(n);
+    }
+
+    BasicEulerTourTree(const BasicEulerTourTree &) = delete;
+    BasicEulerTourTree &operator=(const BasicEulerTourTree &) = delete;
+
+    // The nodes belong to vertices and arc_nodes, so the tree must not
+    // free anything through root
+    ~BasicEulerTourTree() {
+        Tree::root = nullptr;
+    }
+
+    int size() const {
+        return vertices.size();
+    }
+
+    // Number of edges in the forest
+    int edge_count() const {
+        return arcs.size() / 2;
+    }
+
+    bool connected(int u, int v) {
+        int u_depth, v_depth;
+        Node *u_root = find_root(&vertices[u], u_depth);
+        Node *v_root = find_root(&vertices[v], v_depth);
+        touch(&vertices[u], u_depth);
+        touch(&vertices[v], v_depth);
+        return u_root == v_root;
+    }
+
+    // Add the edge (u, v); returns false if u and v are already connected
+    bool link(int u, int v) {
+        if (connected(u, v)) return false;
+
+        Node *uv = new_arc(u, v), *vu = new_arc(v, u);
+        Node *tour = reroot(&vertices[u]);
+        tour = concat(tour, uv);
+        tour = concat(tour, reroot(&vertices[v]));
+        concat(tour, vu);
+
+        policy.resize(total_nodes());
+        return true;
+    }
+
+    // Remove the edge (u, v); returns false if there is no such edge
+    bool cut(int u, int v) {
+        auto uv = arcs.find(arc_key(u, v));
+        if (uv == arcs.end()) return false;
+        auto vu = arcs.find(arc_key(v, u));
+
+        // The tour is X first Y second Z, where Y is the side entered
+        // through first; the pieces become the tours X Z and Y
+        Node *first = uv->second, *second = vu->second;
+        int depth;
+        if (position(first, depth) > position(second, depth))
+            swap(first, second);
+
+        Node *x = split_before(first);
+        split_after(first);
+        split_before(second); // Y stays behind as a tour of its own
+        Node *z = split_after(second);
+        concat(x, z);
+
+        arc_nodes.deallocate(first);
+        arc_nodes.deallocate(second);
+        arcs.erase(uv);
+        arcs.erase(vu);
+
+        policy.resize(total_nodes());
+        return true;
+    }
+
+    // Number of vertices in the component of u
+    int component_size(int u) {
+        int depth;
+        int count = get_vertices(find_root(&vertices[u], depth));
+        touch(&vertices[u], depth);
+        return count;
+    }
+
+    // Number of vertices in the subtree of v when the tree is rooted at
+    // parent, which must be a neighbour of v: the component v would be
+    // in after cutting the edge (v, parent)
+    int subtree_size(int v, int parent) {
+        return subtree<int>(v, parent, [](Node *x) { return get_vertices(x); },
+                            [](Node *x) { return int(x->is_vertex); });
+    }
+
+    // Sum of the vertex values in the subtree of v, as for subtree_size
+    long long subtree_sum(int v, int parent) {
+        return subtree<long long>(v, parent, [](Node *x) { return get_sum(x); },
+                                  [](Node *x) { return x->value; });
+    }
+
+    // Set the value of vertex v
+    void set_value(int v, long long value) {
+        Node *x = &vertices[v];
+        x->value = value;
+        int depth = 0;
+        for (Node *node = x; node != nullptr; node = node->parent) {
+            node->join();
+            depth++;
+        }
+        touch(x, depth);
+    }
+
+private:
+    using Tree::find_root;
+    using Tree::split_before;
+    using Tree::split_after;
+    using Tree::concat;
+
+    unordered_map<uint64_t, Node *> arcs;
+    arena::NodeArena<Node> arc_nodes;
+
+    static uint64_t arc_key(int u, int v) {
+        return uint64_t(uint32_t(u)) << 32 | uint32_t(v);
+    }
+
+    int total_nodes() const {
+        return vertices.size() + arcs.size();
+    }
+
+    Node *new_arc(int u, int v) {
+        Node *x = arc_nodes.allocate();
+        x->join();
+        arcs[arc_key(u, v)] = x;
+        return x;
+    }
+
+    // Apply the depth rule to an access of x at the given depth
+    void touch(Node *x, int depth) {
+        if (policy.should_splay(depth, x))
+            splay(x);
+    }
+
+    // Number of nodes before x in its sequence; depth receives the depth of x
+    static int position(Node *x, int &depth) {
+        return prefix<int>(x, depth, [](Node *y) { return get_size(y); }, [](Node *) { return 1; });
+    }
+
+    // Aggregate of the nodes before x in its sequence, without
+    // restructuring, given the aggregate of a subtree and of a single node
+    template <typename T, typename Subtree, typename Single>
+    static T prefix(Node *x, int &depth, Subtree subtree, Single single) {
+        T total = subtree(x->child[0]);
+        depth = 1;
+        for (Node *node = x; node->parent != nullptr; node = node->parent) {
+            if (node->parent_index() == 1)
+                total += subtree(node->parent->child[0]) + single(node->parent);
+            depth++;
+        }
+        return total;
+    }
+
+    // Aggregate over the vertices of v's side of the edge (v, parent)
+    template <typename T, typename Subtree, typename Single>
+    T subtree(int v, int parent, Subtree subtree, Single single) {
+        Node *down = arcs.at(arc_key(parent, v)), *up = arcs.at(arc_key(v, parent));
+
+        int down_depth, up_depth, depth;
+        T before_down = prefix<T>(down, down_depth, subtree, single);
+        T before_up = prefix<T>(up, up_depth, subtree, single);
+        T total = subtree(find_root(down, depth));
+        bool entered = position(down, depth) < position(up, depth);
+
+        touch(down, down_depth);
+        touch(up, up_depth);
+
+        // Entered through parent -> v, the subtree lies between the arcs;
+        // otherwise the tour starts inside it and it is everything else
+        if (entered)
+            return before_up - before_down;
+        return total - (before_down - before_up);
+    }
+
+    // Rotate the tour of x's tree so that it starts at x; returns its root
+    Node *reroot(Node *x) {
+        Node *left = split_before(x);
+        return concat(x, left);
+    }
+};
+
+using EulerTourTree = BasicEulerTourTree<>;
+
+// Every query splays its node, as in a classic splay-based Euler-tour tree
+using ClassicEulerTourTree = BasicEulerTourTree<splay_policy::LogDepth<ratio<0>>>;
+
+}
+#endif
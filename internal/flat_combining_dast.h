@@ -0,0 +1,134 @@
+#ifndef FLAT_COMBINING_DAST_H
+#define FLAT_COMBINING_DAST_H
+
+#include <bits/stdc++.h>
+#include "depth_aware_splay_tree.h"
+using namespace std;
+
+namespace flat_combining {
+
+enum class Operation { Insert, LowerBound, Remove };
+
+// One published request per thread, on its own cache line
+struct alignas(64) Request {
+    enum State { Empty, Pending, Done };
+
+    atomic<int> state{Empty};
+    Operation operation;
+    int key;
+    bool found;  // lower_bound found a key, remove removed one
+    int result;  // Key found by lower_bound
+};
+
+// Flat-combining front end for dast::DepthAwareSplayTree. A thread publishes
+// its request in its own slot and then either waits for it to be served or,
+// if it wins the lock, becomes the combiner: it collects every pending
+// request, sorts the batch by key so that consecutive operations walk
+// overlapping paths, and runs it with splaying deferred. The batch ends
+// with at most one splay, for the deepest access the depth rule flagged.
+//
+// Each thread must use its own slot in [0, max_threads).
+struct DepthAwareSplayTree {
+    using Tree = dast::BasicDepthAwareSplayTree<splay_policy::Deferred<>>;
+
+    Tree tree;
+    int max_threads;
+
+    // Number of batches run and requests served, for tuning
+    long long batches = 0;
+    long long served = 0;
+
+    explicit DepthAwareSplayTree(int max_threads = 128)
+        : max_threads(max_threads), requests(new Request[max_threads]) {}
+
+    void insert(int slot, int key) {
+        submit(slot, Operation::Insert, key);
+    }
+
+    // Find the smallest key >= the given key; returns false if there is none
+    bool lower_bound(int slot, int key, int &result) {
+        Request &request = submit(slot, Operation::LowerBound, key);
+        result = request.result;
+        return request.found;
+    }
+
+    // Remove one occurrence of the key; returns false if it is absent
+    bool remove(int slot, int key) {
+        return submit(slot, Operation::Remove, key).found;
+    }
+
+private:
+    mutex lock;
+    unique_ptr<Request[]> requests;
+    vector<Request *> batch;
+
+    Request &submit(int slot, Operation operation, int key) {
+        Request &request = requests[slot];
+        request.operation = operation;
+        request.key = key;
+        request.state.store(Request::Pending, memory_order_release);
+
+        while (request.state.load(memory_order_acquire) != Request::Done) {
+            if (lock.try_lock()) {
+                combine();
+                lock.unlock();
+            } else {
+                this_thread::yield();
+            }
+        }
+
+        request.state.store(Request::Empty, memory_order_relaxed);
+        return request;
+    }
+
+    // Serve every pending request; called with the lock held
+    void combine() {
+        batch.clear();
+        for (int i = 0; i < max_threads; i++) {
+            if (requests[i].state.load(memory_order_acquire) == Request::Pending)
+                batch.push_back(&requests[i]);
+        }
+
+        stable_sort(batch.begin(), batch.end(), [](Request *a, Request *b) { return a->key < b->key; });
+
+        tree.policy.deferred = true;
+        for (Request *request : batch)
+            execute(*request);
+        tree.policy.deferred = false;
+
+        if (tree.policy.pending) {
+            tree.policy.pending = false;
+            tree.policy.pending_depth = 0;
+            tree.lower_bound(tree.policy.pending_key);
+        }
+
+        for (Request *request : batch)
+            request->state.store(Request::Done, memory_order_release);
+
+        batches++;
+        served += batch.size();
+    }
+
+    void execute(Request &request) {
+        switch (request.operation) {
+        case Operation::Insert:
+            tree.insert(request.key);
+            break;
+        case Operation::LowerBound: {
+            dast::Node *x = tree.lower_bound(request.key);
+            request.found = x != nullptr;
+            if (x) request.result = x->key;
+            break;
+        }
+        case Operation::Remove: {
+            dast::Node *x = tree.lower_bound(request.key);
+            request.found = x != nullptr && x->key == request.key;
+            if (request.found) tree.remove(x);
+            break;
+        }
+        }
+    }
+};
+
+}
+#endif
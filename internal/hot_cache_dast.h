@@ -0,0 +1,178 @@
+#ifndef HOT_CACHE_DAST_H
+#define HOT_CACHE_DAST_H
+
+#include <bits/stdc++.h>
+#include "depth_aware_splay_tree.h"
+using namespace std;
+
+namespace hot_cache {
+
+// One set of the lookup cache: Ways query keys with the node each one
+// found, as a handle (node and generation; the layout generation is kept
+// once for the whole cache). A set fills exactly 16 * Ways bytes and is
+// aligned to that, so probing it touches a single cache line.
+template <int Ways>
+struct alignas(16 * Ways) Set {
+    dast::Node *node[Ways];
+    int key[Ways];
+    uint16_t generation[Ways];
+    uint8_t victim;  // Way replaced on the next miss
+};
+
+// Small set-associative cache in front of dast::BasicDepthAwareSplayTree
+// for hot exact-match lookups. lower_bound probes the set the query hashes
+// to first; a hit returns the cached node without descending or splaying.
+// Only lookups that find their exact key are cached, since an insert could
+// change the answer for any other query. An entry is dropped when its node
+// is removed or re-keyed through this wrapper. An entry left stale by
+// changing the tree directly is never returned: a hit also requires the
+// node's generation to match (it was not freed) and the node to still hold
+// the query key (it was not re-keyed by decrease_key), and a relocation
+// flushes the cache. With duplicate keys a hit returns some node with the
+// key, not necessarily the first one.
+//
+// Ways = 1 is direct-mapped; with more ways the victim is the way after
+// the last one hit, which is least-recently-used replacement for 2 ways.
+template <int Ways = 2, typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    static_assert(Ways == 1 || Ways == 2 || Ways == 4, "a set must fill 16, 32 or 64 bytes");
+    static_assert(sizeof(Set<Ways>) == 16 * Ways, "a set must not straddle a cache line");
+
+    using Tree = dast::BasicDepthAwareSplayTree<SplayPolicy>;
+    using Node = dast::Node;
+
+    Tree tree;
+
+    // Lookups served from the cache and from the tree, for tuning
+    long long hits = 0;
+    long long misses = 0;
+
+    // The cache holds sets * Ways entries; sets is rounded up to a power of two
+    explicit BasicDepthAwareSplayTree(int sets = 1024) {
+        int bits = 0;
+        while ((1 << bits) < sets) bits++;
+        shift = 32 - bits;
+        cache.resize(size_t(1) << bits);
+        flush();
+    }
+
+    int size() const {
+        return tree.size;
+    }
+
+    Node *insert(int key) {
+        return tree.insert(key);
+    }
+
+    // Find the node with the smallest key >= the given key
+    Node *lower_bound(int key) {
+        if (layout != tree.layout_generation)
+            flush();
+
+        Set<Ways> &set = cache[set_of(key)];
+        for (int way = 0; way < Ways; way++) {
+            Node *x = set.node[way];
+            if (x && set.key[way] == key && x->generation == set.generation[way] && x->key == key) {
+                if (set.victim == way) set.victim = (way + 1) % Ways;
+                hits++;
+                return x;
+            }
+        }
+
+        misses++;
+        Node *answer = tree.lower_bound(key);
+
+        // The lookup may have triggered an automatic compact(), which
+        // relocates every node; answer is already the relocated node
+        if (layout != tree.layout_generation)
+            flush();
+
+        if (answer && answer->key == key) {
+            int way = set.victim;
+            set.node[way] = answer;
+            set.key[way] = key;
+            set.generation[way] = answer->generation;
+            set.victim = (way + 1) % Ways;
+        }
+        return answer;
+    }
+
+    // Remove a specific node
+    void remove(Node *x) {
+        if (x == nullptr) return;
+
+        forget(x);
+        tree.remove(x);
+    }
+
+    // Lower the key of a node; see dast::BasicDepthAwareSplayTree::decrease_key
+    void decrease_key(Node *x, int key) {
+        forget(x);
+        tree.decrease_key(x, key);
+    }
+
+    // Remove the minimum and return its key; the tree must not be empty
+    int pop_min() {
+        forget(tree.min());
+        return tree.pop_min();
+    }
+
+    // Remove the maximum and return its key; the tree must not be empty
+    int pop_max() {
+        forget(tree.max());
+        return tree.pop_max();
+    }
+
+    // Remove the node a handle refers to; returns false if it is stale
+    bool remove(const dast::Handle &h) {
+        Node *x = tree.get(h);
+        if (x == nullptr) return false;
+        remove(x);
+        return true;
+    }
+
+    void compact() {
+        tree.compact();
+        flush();
+    }
+
+    void clear() {
+        tree.clear();
+        flush();
+    }
+
+    // Drop every cached entry
+    void flush() {
+        for (auto &set : cache)
+            set = Set<Ways>{};
+        layout = tree.layout_generation;
+    }
+
+private:
+    vector<Set<Ways>> cache;
+    int shift;
+    uint32_t layout = 0;
+
+    // Drop the entry caching x, if any, before x is freed or re-keyed
+    void forget(Node *x) {
+        Set<Ways> &set = cache[set_of(x->key)];
+        for (int way = 0; way < Ways; way++) {
+            if (set.node[way] == x) {
+                set.node[way] = nullptr;
+                set.victim = way;
+            }
+        }
+    }
+
+    // Fibonacci hashing: the top bits of key * 2^32 / phi, so that runs of
+    // consecutive keys spread over all sets
+    size_t set_of(int key) const {
+        return shift == 32 ? 0 : (uint32_t(key) * 2654435769u) >> shift;
+    }
+};
+
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+using DirectMappedDepthAwareSplayTree = BasicDepthAwareSplayTree<1>;
+
+}
+#endif
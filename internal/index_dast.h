@@ -0,0 +1,283 @@
+#ifndef INDEX_DAST_H
+#define INDEX_DAST_H
+
+#include <bits/stdc++.h>
+#include "memory_usage.h"
+#include "splay_policy.h"
+using namespace std;
+
+namespace index_dast {
+
+// Augmentations live in a cold array parallel to the node array, so the
+// descent in lower_bound only touches the hot fields. A default-constructed
+// augmentation is the identity, which is what the null node (index 0) holds.
+struct NoAugment {
+    void join(const NoAugment &, const NoAugment &, int) {}
+};
+
+struct Size {
+    int size = 0;
+
+    void join(const Size &left, const Size &right, int) {
+        size = left.size + right.size + 1;
+    }
+};
+
+struct SizeSum {
+    int size = 0;
+    long long sum = 0;
+
+    void join(const SizeSum &left, const SizeSum &right, int key) {
+        size = left.size + right.size + 1;
+        sum = left.sum + right.sum + key;
+    }
+};
+
+// Hot node fields: links are indices into the node array, 0 meaning null.
+// With 32-bit indices a node is 16 bytes instead of 32.
+template <typename Index>
+struct Node {
+    Index parent = 0;
+    Index child[2] = {0, 0};
+    int key = 0;
+};
+
+// Depth-aware splay tree over an index-linked node array. Index selects the
+// link width (uint32_t for trees under 4B nodes), Augment the cold per-node
+// data and SplayPolicy the splay rule (see splay_policy.h).
+template <typename Augment = NoAugment, typename Index = uint32_t, typename SplayPolicy = splay_policy::LogDepth<>>
+struct DepthAwareSplayTree {
+    static constexpr bool AUGMENTED = !is_empty<Augment>::value;
+
+    int size = 0;
+    SplayPolicy policy;
+
+    Index root = 0;
+    vector<Node<Index>> nodes = vector<Node<Index>>(1); // Index 0 is the null node
+    vector<Augment> cold = vector<Augment>(AUGMENTED);  // Augmentations, when any
+    Index free_list = 0;                                 // Linked through child[0]
+
+    int key(Index x) const {
+        return nodes[x].key;
+    }
+
+    const Augment &augment(Index x) const {
+        return cold[x];
+    }
+
+    // Set a child node and update its parent pointer
+    void set_child(Index x, int index, Index child_node) {
+        nodes[x].child[index] = child_node;
+        if (child_node)
+            nodes[child_node].parent = x;
+    }
+
+    // Determine the index of a node relative to its parent
+    int parent_index(Index x) const {
+        Index p = nodes[x].parent;
+        return p == 0 ? -1 : int(x == nodes[p].child[1]);
+    }
+
+    void join(Index x) {
+        if constexpr (AUGMENTED)
+            cold[x].join(cold[nodes[x].child[0]], cold[nodes[x].child[1]], nodes[x].key);
+    }
+
+    // Set a new root for the tree
+    Index set_root(Index x) {
+        if (x)
+            nodes[x].parent = 0;
+        return root = x;
+    }
+
+    Index allocate(int key) {
+        Index x = free_list;
+        if (x) {
+            free_list = nodes[x].child[0];
+            nodes[x] = Node<Index>();
+        } else {
+            assert(nodes.size() <= numeric_limits<Index>::max());
+            x = Index(nodes.size());
+            nodes.emplace_back();
+            if constexpr (AUGMENTED)
+                cold.emplace_back();
+        }
+
+        nodes[x].key = key;
+        join(x);
+        return x;
+    }
+
+    void deallocate(Index x) {
+        nodes[x].child[0] = free_list;
+        free_list = x;
+    }
+
+    // Perform a single rotation
+    void rotate_up(Index x) {
+        Index p = nodes[x].parent;
+        Index gp = nodes[p].parent;
+        int index = parent_index(x);
+
+        if (gp) {
+            set_child(gp, parent_index(p), x);
+        } else {
+            set_root(x);
+        }
+
+        set_child(p, index, nodes[x].child[!index]);
+        set_child(x, !index, p);
+
+        join(p);
+    }
+
+    // Splay operation to move a node to the root
+    void splay(Index x) {
+        while (x != root) {
+            Index p = nodes[x].parent;
+            if (p != root)
+                rotate_up(parent_index(x) == parent_index(p) ? p : x);
+            rotate_up(x);
+        }
+
+        join(x);
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+
+        policy.resize(size);
+        Index x = allocate(key);
+
+        if (root == 0) {
+            set_root(x);
+            return;
+        }
+
+        Index current = root, previous = 0;
+        int depth = 0;
+
+        while (current != 0) {
+            depth++;
+            previous = current;
+            current = nodes[current].child[nodes[current].key < key];
+        }
+
+        set_child(previous, int(nodes[previous].key < key), x);
+
+        if (policy.should_splay(depth, &nodes[x]))
+            splay(x);
+
+        if constexpr (AUGMENTED) {
+            for (Index node = x; node != 0; node = nodes[node].parent)
+                join(node);
+        }
+    }
+
+    // Find the node with the smallest key >= the given key, 0 if none
+    Index lower_bound(const int &key) {
+        Index current = root;
+        Index answer = 0;
+        int depth = 0;
+
+        while (current != 0) {
+            depth++;
+
+            if (nodes[current].key < key) {
+                current = nodes[current].child[1];
+            } else {
+                answer = current;
+                current = nodes[current].child[0];
+            }
+        }
+
+        if (answer && policy.should_splay(depth, &nodes[answer])) splay(answer);
+        return answer;
+    }
+
+    // Find the node at the given position in key order (needs a size augmentation)
+    Index node_at_index(int index) {
+        if (index < 0 || index >= size)
+            return 0;
+
+        Index current = root;
+        int depth = 0;
+
+        while (current != 0) {
+            int left_size = cold[nodes[current].child[0]].size;
+            depth++;
+
+            if (index == left_size) {
+                if (policy.should_splay(depth, &nodes[current]))
+                    splay(current);
+                return current;
+            }
+
+            if (index < left_size) {
+                current = nodes[current].child[0];
+            } else {
+                current = nodes[current].child[1];
+                index -= left_size + 1;
+            }
+        }
+
+        assert(false);
+        return 0;
+    }
+
+    // Remove a specific node
+    void remove(Index x) {
+        if (x == 0) return;
+
+        size--;
+        policy.resize(size);
+        splay(x); // Bring x to the root
+
+        Index left_subtree = nodes[x].child[0];
+        Index right_subtree = nodes[x].child[1];
+        if (left_subtree) nodes[left_subtree].parent = 0;
+        if (right_subtree) nodes[right_subtree].parent = 0;
+
+        deallocate(x); // Free the slot for reuse
+
+        if (!left_subtree) {
+            set_root(right_subtree);
+        } else {
+            set_root(left_subtree);
+            Index max_left = left_subtree;
+            while (nodes[max_left].child[1]) {
+                max_left = nodes[max_left].child[1];
+            }
+            splay(max_left); // Bring max of left subtree to the root
+            set_child(max_left, 1, right_subtree);
+            join(max_left);
+            set_root(max_left);
+        }
+    }
+
+    // Heap bytes held by the tree; slack covers vector capacity, free slots
+    // and the null node
+    memory::Usage memory_usage() const {
+        memory::Usage usage;
+        size_t augment_bytes = AUGMENTED ? sizeof(Augment) : 0;
+        usage.nodes = size * (sizeof(Node<Index>) + augment_bytes);
+        usage.augmentation = size * augment_bytes;
+        usage.slack = nodes.capacity() * sizeof(Node<Index>) + cold.capacity() * sizeof(Augment) - usage.nodes;
+        return usage;
+    }
+
+    // Clear the entire tree
+    void clear() {
+        nodes.assign(1, Node<Index>());
+        nodes.shrink_to_fit();
+        cold.assign(AUGMENTED, Augment());
+        cold.shrink_to_fit();
+        root = 0;
+        free_list = 0;
+        size = 0;
+    }
+};
+
+}
+#endif
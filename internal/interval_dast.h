@@ -0,0 +1,259 @@
+#ifndef INTERVAL_DAST_H
+#define INTERVAL_DAST_H
+
+#include <bits/stdc++.h>
+#include "splay_policy.h"
+using namespace std;
+
+namespace interval_dast {
+
+// Node structure for the interval Splay Tree: keyed by the start of the
+// closed interval [start, end], augmented with the largest end in the subtree
+struct Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    int start;
+    int end;
+    int max_end;
+
+    friend int get_max_end(Node *x) {
+        return x == nullptr ? INT_MIN : x->max_end;
+    }
+
+    // Set a child node and update its parent pointer
+    void set_child(int index, Node *child_node) {
+        child[index] = child_node;
+        if (child_node)
+            child_node->parent = this;
+    }
+
+    // Determine the index of this node relative to its parent
+    int parent_index() const {
+        return parent == nullptr ? -1 : int(this == parent->child[1]);
+    }
+
+    void join() {
+        max_end = max(end, max(get_max_end(child[0]), get_max_end(child[1])));
+    }
+
+    ~Node() {
+        // Recursively delete children
+        delete child[0];
+        delete child[1];
+    }
+};
+
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    int size = 0;
+    SplayPolicy policy;
+
+    Node *root = nullptr;
+
+    // Set a new root for the tree
+    Node *set_root(Node *x) {
+        if (x)
+            x->parent = nullptr;
+        return root = x;
+    }
+
+    // Perform a single rotation
+    void rotate_up(Node *x) {
+        Node *p = x->parent;
+        Node *gp = p->parent;
+        int index = x->parent_index();
+
+        if (gp) {
+            gp->set_child(p->parent_index(), x);
+        } else {
+            set_root(x);
+        }
+
+        p->set_child(index, x->child[!index]);
+        x->set_child(!index, p);
+
+        p->join();
+    }
+
+    // Splay operation to move a node to the root
+    void splay(Node *x) {
+        while (x != root) {
+            if (x->parent != root)
+                rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
+            rotate_up(x);
+        }
+
+        x->join();
+    }
+
+    // Insert the closed interval [start, end]
+    Node *insert(int start, int end) {
+        size++;
+
+        policy.resize(size);
+        Node *x = new Node();
+        x->start = start;
+        x->end = x->max_end = end;
+
+        if (root == nullptr) {
+            set_root(x);
+            return x;
+        }
+
+        Node *current = root, *previous = nullptr;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+            previous = current;
+            current = current->child[current->start < start];
+        }
+
+        previous->set_child(int(previous->start < start), x);
+
+        // Only the max_end values on the path can change
+        for (Node *node = previous; node != nullptr && node->max_end < end; node = node->parent)
+            node->max_end = end;
+
+        if (policy.should_splay(depth, x))
+            splay(x);
+
+        return x;
+    }
+
+    // Report every interval containing t, in order of start. The in-order
+    // walk skips subtrees whose max_end is below t and stops at the first
+    // start after t, so the cost is output-sensitive. The first result is
+    // splayed only if the depth rule fires for it.
+    template <typename Report>
+    void stab(int t, Report report) {
+        Node *first = nullptr;
+        int first_depth = 0;
+
+        vector<pair<Node *, int>> stack;
+        Node *current = root;
+        int depth = 1;
+
+        while (true) {
+            while (current != nullptr && current->max_end >= t) {
+                stack.push_back({current, depth});
+                current = current->child[0];
+                depth++;
+            }
+
+            if (stack.empty())
+                break;
+
+            auto [x, x_depth] = stack.back();
+            stack.pop_back();
+            if (x->start > t)
+                break; // Everything after x in key order starts after t too
+
+            if (t <= x->end) {
+                report(x);
+                if (first == nullptr) {
+                    first = x;
+                    first_depth = x_depth;
+                }
+            }
+
+            current = x->child[1];
+            depth = x_depth + 1;
+        }
+
+        if (first && policy.should_splay(first_depth, first))
+            splay(first);
+    }
+
+    // Find any interval overlapping [low, high], or nullptr. Follows a single
+    // path: go left whenever the left subtree could hold an overlap.
+    Node *overlap(int low, int high) {
+        Node *current = root;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+
+            if (current->start <= high && low <= current->end)
+                break;
+
+            if (get_max_end(current->child[0]) >= low)
+                current = current->child[0];
+            else
+                current = current->child[1];
+        }
+
+        if (current && policy.should_splay(depth, current))
+            splay(current);
+        return current;
+    }
+
+    // Report every interval overlapping [low, high], in no particular order
+    template <typename Report>
+    void overlaps(int low, int high, Report report) {
+        vector<Node *> stack;
+        if (root) stack.push_back(root);
+
+        while (!stack.empty()) {
+            Node *x = stack.back();
+            stack.pop_back();
+            if (x->max_end < low)
+                continue;
+
+            if (x->child[0]) stack.push_back(x->child[0]);
+            if (x->start <= high) {
+                if (low <= x->end) report(x);
+                if (x->child[1]) stack.push_back(x->child[1]);
+            }
+        }
+    }
+
+    // Remove a specific node
+    void remove(Node *x) {
+        if (x == nullptr) return;
+
+        size--;
+        policy.resize(size);
+        splay(x); // Bring x to the root
+
+        if (x->child[0]) x->child[0]->parent = nullptr;
+        if (x->child[1]) x->child[1]->parent = nullptr;
+
+        Node *left_subtree = x->child[0];
+        Node *right_subtree = x->child[1];
+
+        x->child[0] = x->child[1] = nullptr;
+        delete x; // Free memory for the node
+
+        if (!left_subtree) {
+            set_root(right_subtree);
+        } else {
+            set_root(left_subtree);
+            Node *max_left = left_subtree;
+            while (max_left->child[1]) {
+                max_left = max_left->child[1];
+            }
+            splay(max_left); // Bring max of left subtree to the root
+            max_left->set_child(1, right_subtree);
+            max_left->join();
+            set_root(max_left);
+        }
+    }
+
+    // Clear the entire tree
+    void clear() {
+        delete root;
+        root = nullptr;
+        size = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~BasicDepthAwareSplayTree() {
+        clear();
+    }
+};
+
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
+}
+#endif
@@ -0,0 +1,114 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace latency {
+
+// Log-bucketed latency histogram in the style of HdrHistogram. Values are
+// nanoseconds, grouped into power-of-two ranges that are each split into
+// SUB_BUCKETS linear buckets, so every value is kept to within 1/SUB_BUCKETS
+// relative precision (about 3%) in constant memory and constant time.
+struct Histogram {
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int RANGES = 64 - SUB_BUCKET_BITS + 1;
+
+    array<uint64_t, RANGES * SUB_BUCKETS> counts{};
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+    double sum = 0;
+
+    // Range 0 holds 0 .. SUB_BUCKETS - 1 exactly; range r >= 1 holds
+    // [SUB_BUCKETS << (r - 1), SUB_BUCKETS << r) in buckets of width 2^(r - 1)
+    static int bucket_of(uint64_t value) {
+        if (value < SUB_BUCKETS) return value;
+        int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + int((value >> shift) - SUB_BUCKETS);
+    }
+
+    // Largest value that falls in the given bucket
+    static uint64_t bucket_max(int bucket) {
+        int range = bucket / SUB_BUCKETS, sub = bucket % SUB_BUCKETS;
+        if (range == 0) return sub;
+        uint64_t width = uint64_t(1) << (range - 1);
+        return (uint64_t(SUB_BUCKETS + sub) << (range - 1)) + width - 1;
+    }
+
+    void record(uint64_t nanoseconds) {
+        counts[bucket_of(nanoseconds)]++;
+        total++;
+        max_value = max(max_value, nanoseconds);
+        sum += nanoseconds;
+    }
+
+    template <typename Rep, typename Period>
+    void record(chrono::duration<Rep, Period> elapsed) {
+        record(uint64_t(max<int64_t>(0, chrono::duration_cast<chrono::nanoseconds>(elapsed).count())));
+    }
+
+    void merge(const Histogram &other) {
+        for (size_t i = 0; i < counts.size(); i++)
+            counts[i] += other.counts[i];
+        total += other.total;
+        max_value = max(max_value, other.max_value);
+        sum += other.sum;
+    }
+
+    void clear() {
+        *this = Histogram();
+    }
+
+    // Value at the given percentile (0-100) in nanoseconds, reported as the
+    // top of its bucket so it never understates the tail
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = max<uint64_t>(1, ceil(p / 100 * total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank)
+                return min(bucket_max(i), max_value);
+        }
+        return max_value;
+    }
+
+    double mean() const {
+        return total ? sum / total : 0;
+    }
+
+    // p50, p99, p99.9 and max in microseconds, matching summary_columns
+    vector<double> summary() const {
+        return {percentile(50) / 1e3, percentile(99) / 1e3, percentile(99.9) / 1e3, max_value / 1e3};
+    }
+
+    static vector<string> summary_columns(const string &name) {
+        return {name + "(p50)", name + "(p99)", name + "(p99.9)", name + "(max)"};
+    }
+};
+
+// Flag a tail regression: the candidate's p99.9 exceeds the baseline's by
+// more than the given factor. Prints a line either way and returns whether
+// it regressed.
+inline bool compare_tail(const string &candidate_name, const Histogram &candidate,
+                         const string &baseline_name, const Histogram &baseline, double tolerance = 1.1) {
+    double candidate_tail = candidate.percentile(99.9) / 1e3;
+    double baseline_tail = baseline.percentile(99.9) / 1e3;
+    bool regressed = candidate_tail > baseline_tail * tolerance;
+
+    cout << (regressed ? "  REGRESSION: " : "  ok: ") << candidate_name << " p99.9 " << candidate_tail
+         << "us vs " << baseline_name << " " << baseline_tail << "us" << endl;
+    return regressed;
+}
+
+// Whether the driver was started with --compare, in which case it exits
+// with a failure status when any tail regression was flagged
+inline bool compare_mode(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++)
+        if (string(argv[i]) == "--compare") return true;
+    return false;
+}
+
+}
+#endif
@@ -0,0 +1,222 @@
+#ifndef LINK_CUT_DAST_H
+#define LINK_CUT_DAST_H
+
+#include <bits/stdc++.h>
+#include "splay_policy.h"
+using namespace std;
+
+namespace link_cut {
+
+// Node of an auxiliary splay tree. Each auxiliary tree holds one preferred
+// path of the represented forest, ordered from top to bottom. The parent
+// of an auxiliary root is the path-parent: the node the path hangs from
+// in the represented tree.
+struct Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    long long value = 0;
+    long long sum = 0;
+    bool reversed = false;  // Pending reversal: the children are swapped lazily
+
+    friend long long get_sum(Node *x) {
+        return x == nullptr ? 0LL : x->sum;
+    }
+
+    // Whether this node is the root of its auxiliary tree
+    bool is_root() const {
+        return parent == nullptr || (parent->child[0] != this && parent->child[1] != this);
+    }
+
+    void join() {
+        sum = get_sum(child[0]) + get_sum(child[1]) + value;
+    }
+
+    // Apply a pending reversal to the children
+    void push() {
+        if (!reversed) return;
+        swap(child[0], child[1]);
+        for (Node *c : child)
+            if (c) c->reversed = !c->reversed;
+        reversed = false;
+    }
+};
+
+// Link-cut tree over the vertices 0 .. n - 1, with a value per vertex and
+// path sums. Structural operations (link, cut, path_aggregate, lca) must
+// expose a path and splay as usual. find_root, and with it connected, is
+// where the depth-aware rule applies: it first walks to the root without
+// modifying anything, and only falls back to access and splay when that
+// walk is at least SplayPolicy's threshold long, with the forest size as
+// the tree size. A threshold of 0 gives the classic link-cut tree.
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicLinkCutTree {
+    vector<Node> nodes;
+    SplayPolicy policy;
+
+    explicit BasicLinkCutTree(int n) : nodes(n) {
+        policy.resize(n);
+    }
+
+    int size() const {
+        return nodes.size();
+    }
+
+    // Set the value of vertex v
+    void set_value(int v, long long value) {
+        Node *x = &nodes[v];
+        access(x);
+        x->value = value;
+        x->join();
+    }
+
+    // Root of the tree containing v
+    int find_root(int v) {
+        Node *x = &nodes[v];
+
+        // Climb to the auxiliary tree of the root path, then descend to its
+        // first node, taking pending reversals into account
+        int depth = 1;
+        Node *top = x;
+        while (top->parent) {
+            top = top->parent;
+            depth++;
+        }
+
+        Node *first = top;
+        bool flip = false;
+        while (true) {
+            flip ^= first->reversed;
+            Node *next = first->child[flip];
+            if (next == nullptr) break;
+            first = next;
+            depth++;
+        }
+
+        if (!policy.should_splay(depth, first))
+            return first - nodes.data();
+
+        access(x);
+        first = x;
+        first->push();
+        while (first->child[0]) {
+            first = first->child[0];
+            first->push();
+        }
+        splay(first);
+        return first - nodes.data();
+    }
+
+    bool connected(int u, int v) {
+        return find_root(u) == find_root(v);
+    }
+
+    // Add the edge (u, v); returns false if u and v are already connected
+    bool link(int u, int v) {
+        if (connected(u, v)) return false;
+        make_root(&nodes[u]);
+        nodes[u].parent = &nodes[v];
+        return true;
+    }
+
+    // Remove the edge (u, v); returns false if there is no such edge
+    bool cut(int u, int v) {
+        Node *x = &nodes[u], *y = &nodes[v];
+        make_root(x);
+        access(y);
+
+        // With u as the root, the edge exists iff the path u .. v is just u, v
+        if (y->child[0] != x || x->child[1] != nullptr)
+            return false;
+
+        y->child[0] = nullptr;
+        x->parent = nullptr;
+        y->join();
+        return true;
+    }
+
+    // Sum of the values on the path between u and v, which must be connected.
+    // Makes u the root of its tree.
+    long long path_aggregate(int u, int v) {
+        make_root(&nodes[u]);
+        access(&nodes[v]);
+        return nodes[v].sum;
+    }
+
+    // Lowest common ancestor of u and v under the current rooting, or -1
+    // if they are not connected
+    int lca(int u, int v) {
+        if (!connected(u, v)) return -1;
+        access(&nodes[u]);
+        return access(&nodes[v]) - nodes.data();
+    }
+
+    // Make x the root of its tree
+    void make_root(Node *x) {
+        access(x);
+        x->reversed = !x->reversed;
+    }
+
+    // Make the path from the root to x preferred and splay x to the root of
+    // its auxiliary tree, which then holds exactly that path. Returns the
+    // last node where the walk joined the root path.
+    Node *access(Node *x) {
+        Node *last = nullptr;
+        for (Node *current = x; current != nullptr; current = current->parent) {
+            splay(current);
+            current->child[1] = last;
+            current->join();
+            last = current;
+        }
+        splay(x);
+        return last;
+    }
+
+    // Perform a single rotation within an auxiliary tree
+    void rotate_up(Node *x) {
+        Node *p = x->parent;
+        Node *gp = p->parent;
+        int index = int(p->child[1] == x);
+
+        if (!p->is_root())
+            gp->child[gp->child[1] == p] = x;
+        x->parent = gp;
+
+        p->child[index] = x->child[!index];
+        if (p->child[index]) p->child[index]->parent = p;
+        x->child[!index] = p;
+        p->parent = x;
+
+        p->join();
+        x->join();
+    }
+
+    // Splay x to the root of its auxiliary tree
+    void splay(Node *x) {
+        // Apply pending reversals from the auxiliary root down to x
+        path.clear();
+        for (Node *current = x;; current = current->parent) {
+            path.push_back(current);
+            if (current->is_root()) break;
+        }
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+            (*it)->push();
+
+        while (!x->is_root()) {
+            Node *p = x->parent;
+            if (!p->is_root())
+                rotate_up((p->child[1] == x) == (p->parent->child[1] == p) ? p : x);
+            rotate_up(x);
+        }
+    }
+
+private:
+    vector<Node *> path;
+};
+
+using LinkCutTree = BasicLinkCutTree<>;
+
+// The classic link-cut tree: every find_root accesses and splays
+using ClassicLinkCutTree = BasicLinkCutTree<splay_policy::LogDepth<ratio<0>>>;
+
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef MEMORY_COUNTER_H
+#define MEMORY_COUNTER_H
+
+#include <bits/stdc++.h>
+#include <malloc.h>
+using namespace std;
+
+// Replaces the global allocation functions to keep a running count of live
+// heap bytes, including allocator slack. Include from one translation unit
+// only (every benchmark driver is a single translation unit).
+namespace memory {
+
+inline size_t live_bytes = 0;
+
+inline size_t current_bytes() {
+    return live_bytes;
+}
+
+inline void *counted(void *p) {
+    if (p == nullptr) throw bad_alloc();
+    live_bytes += malloc_usable_size(p);
+    return p;
+}
+
+inline void uncounted(void *p) {
+    if (p == nullptr) return;
+    live_bytes -= malloc_usable_size(p);
+    free(p);
+}
+
+}
+
+void *operator new(size_t n) {
+    return memory::counted(malloc(n));
+}
+
+void *operator new[](size_t n) {
+    return memory::counted(malloc(n));
+}
+
+void *operator new(size_t n, align_val_t align) {
+    return memory::counted(aligned_alloc(size_t(align), (n + size_t(align) - 1) / size_t(align) * size_t(align)));
+}
+
+void *operator new[](size_t n, align_val_t align) {
+    return memory::counted(aligned_alloc(size_t(align), (n + size_t(align) - 1) / size_t(align) * size_t(align)));
+}
+
+void operator delete(void *p) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete[](void *p) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete(void *p, align_val_t) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete[](void *p, align_val_t) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete(void *p, size_t, align_val_t) noexcept {
+    memory::uncounted(p);
+}
+
+void operator delete[](void *p, size_t, align_val_t) noexcept {
+    memory::uncounted(p);
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace memory {
+
+// Heap footprint of a tree as the tree itself accounts for it, returned by
+// the trees' memory_usage(). Per-allocation overhead of the heap allocator
+// is not visible from inside the tree; memory_counter.h measures that.
+struct Usage {
+    size_t nodes = 0;         // Bytes of live nodes, augmentation included
+    size_t slack = 0;         // Bytes reserved but not holding a live node
+    size_t augmentation = 0;  // Part of nodes taken by augmented fields
+    size_t overhead = 0;      // Part of nodes taken by other bookkeeping
+    size_t tables = 0;        // Bytes held outside the nodes, such as handle slots
+
+    size_t total() const {
+        return nodes + slack + tables;
+    }
+};
+
+}
+#endif
@@ -0,0 +1,281 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace arena {
+
+// Whether T has a generation counter, which the arena bumps whenever a node
+// is freed and keeps when the storage is reused, so that stale references
+// to the node can be detected
+template <typename T, typename = void>
+struct has_generation : false_type {};
+
+template <typename T>
+struct has_generation<T, void_t<decltype(declval<T &>().generation)>> : true_type {};
+
+// Reference to a node that survives relocation: an index into the slot
+// table of the arena that issued it, checked against the slot's generation.
+// Table ids are drawn from one process-wide sequence, so a handle is
+// rejected by every arena other than the one that issued it.
+struct Handle {
+    uint32_t table = 0;
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+};
+
+// Next value of the process-wide table sequence; never 0, the table of an
+// empty Handle, until it wraps after 2^32 tables
+inline uint32_t next_table_id() {
+    static atomic<uint32_t> counter{0};
+    return ++counter;
+}
+
+// Block allocator for tree nodes. Nodes are carved out of large blocks and
+// recycled through an intrusive free list, so a whole tree can be released
+// at once and its nodes can be relocated into a single fresh block.
+// Nodes that have been given a Handle are tracked in a slot table, which
+// relocation rewrites and adoption carries over, so handles stay valid
+// until the node is freed.
+template <typename T>
+struct NodeArena {
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    struct Block {
+        T *nodes;
+        size_t capacity;
+    };
+
+    vector<Block> blocks;
+    size_t used = 0;          // Nodes handed out from the last block
+    T *free_list = nullptr;   // Released nodes, linked through their storage
+    T *free_tail = nullptr;   // Last node of free_list, so that lists join in O(1)
+    size_t live = 0;          // Nodes currently in use
+
+    // Slot table behind handles; slot_of only holds nodes that have one,
+    // so an arena whose nodes never get a handle pays one empty check per
+    // free
+    struct Slot {
+        T *node;
+        uint32_t generation;
+    };
+    vector<Slot> slots;
+    vector<uint32_t> free_slots;
+    unordered_map<T *, uint32_t> slot_of;
+    uint32_t table = next_table_id();
+
+    // Tables of adopted arenas, whose slots [offset, offset + count) were
+    // appended to ours
+    struct Alias {
+        uint32_t table, offset, count;
+    };
+    vector<Alias> aliases;
+
+    // Start a new block with room for at least n nodes
+    void reserve_block(size_t n) {
+        n = max<size_t>(n, 1);
+        blocks.push_back({static_cast<T *>(::operator new(n * sizeof(T), align_val_t(alignof(T)))), n});
+        used = 0;
+    }
+
+    // Hand out a default-constructed node
+    T *allocate() {
+        static_assert(sizeof(T) >= sizeof(T *), "node too small for free list");
+        live++;
+
+        if (free_list) {
+            T *x = free_list;
+            free_list = *reinterpret_cast<T **>(x);
+            if (free_list == nullptr) free_tail = nullptr;
+            if constexpr (has_generation<T>::value) {
+                auto generation = x->generation;
+                new (x) T();
+                x->generation = generation;
+                return x;
+            }
+            return new (x) T();
+        }
+
+        if (blocks.empty() || used == blocks.back().capacity)
+            reserve_block(BLOCK_SIZE);
+
+        return new (blocks.back().nodes + used++) T();
+    }
+
+    // Return a node to the free list
+    void deallocate(T *x) {
+        live--;
+        if (!slot_of.empty()) release_slot(x);
+        if constexpr (has_generation<T>::value) {
+            // The node is not destroyed, so the compiler cannot drop the
+            // bump as a store to a dead object; the counter lies past the
+            // free list link, so it survives until the storage is reused
+            static_assert(is_trivially_destructible<T>::value, "generation counted nodes must be trivial");
+            x->generation++;
+        } else {
+            x->~T();
+        }
+        *reinterpret_cast<T **>(x) = free_list;
+        if (free_list == nullptr) free_tail = x;
+        free_list = x;
+    }
+
+    // Handle to x, a node of this arena, or an empty handle for nullptr
+    Handle handle(T *x) {
+        if (x == nullptr) return Handle{};
+
+        auto [it, inserted] = slot_of.try_emplace(x, 0);
+        if (inserted) {
+            if (free_slots.empty()) {
+                free_slots.push_back(slots.size());
+                slots.push_back({nullptr, 0});
+            }
+            it->second = free_slots.back();
+            free_slots.pop_back();
+            slots[it->second].node = x;
+        }
+        return Handle{table, it->second, slots[it->second].generation};
+    }
+
+    // Node a handle refers to, or nullptr if it was freed since or comes
+    // from another arena
+    T *get(const Handle &h) const {
+        uint32_t slot = h.slot;
+        if (h.table != table) {
+            auto alias = find_if(aliases.begin(), aliases.end(), [&](const Alias &a) { return a.table == h.table; });
+            if (alias == aliases.end() || slot >= alias->count) return nullptr;
+            slot += alias->offset;
+        }
+        if (slot >= slots.size() || slots[slot].generation != h.generation)
+            return nullptr;
+        return slots[slot].node;
+    }
+
+    // Point the slot table at new addresses: forward(x) gives where the
+    // node at x now lives. Called before the old storage goes away.
+    template <typename Forward>
+    void forward_handles(Forward forward) {
+        unordered_map<T *, uint32_t> moved;
+        moved.reserve(slot_of.size());
+        for (auto [x, slot] : slot_of) {
+            T *y = forward(x);
+            slots[slot].node = y;
+            moved.emplace(y, slot);
+        }
+        slot_of.swap(moved);
+    }
+
+    // Invalidate every handle at once
+    void reset_handles() {
+        slots.clear();
+        free_slots.clear();
+        slot_of.clear();
+        aliases.clear();
+        table = next_table_id();
+    }
+
+    // Bytes held by the slot table
+    size_t handle_bytes() const {
+        return slots.capacity() * sizeof(Slot) + free_slots.capacity() * sizeof(uint32_t) +
+               aliases.capacity() * sizeof(Alias) +
+               slot_of.size() * (sizeof(T *) + sizeof(uint32_t) + 2 * sizeof(void *)) +
+               slot_of.bucket_count() * sizeof(void *);
+    }
+
+    // Bytes reserved by all blocks
+    size_t capacity_bytes() const {
+        size_t total = 0;
+        for (const Block &block : blocks)
+            total += block.capacity * sizeof(T);
+        return total;
+    }
+
+    // Free every block at once; nodes must be trivially destructible
+    void release() {
+        for (const Block &block : blocks)
+            ::operator delete(block.nodes, align_val_t(alignof(T)));
+        blocks.clear();
+        used = 0;
+        free_list = free_tail = nullptr;
+        live = 0;
+        reset_handles();
+    }
+
+    // Take over every block of other, including its free nodes, so that
+    // nodes allocated by other now belong to this arena; other is left
+    // empty. The free lists are joined through other's tail, so this takes
+    // time in the number of blocks only, plus the handles other issued,
+    // which stay valid here.
+    void adopt(NodeArena &other) {
+        adopt_handles(other);
+        if (blocks.empty()) {
+            swap(other);
+            return;
+        }
+
+        if (other.free_list) {
+            *reinterpret_cast<T **>(other.free_tail) = free_list;
+            if (free_list == nullptr) free_tail = other.free_tail;
+            free_list = other.free_list;
+        }
+
+        // Our last block keeps handing out nodes; the unused tail of
+        // other's last block is left as slack
+        blocks.insert(blocks.end() - 1, other.blocks.begin(), other.blocks.end());
+        live += other.live;
+
+        other.blocks.clear();
+        other.used = 0;
+        other.free_list = other.free_tail = nullptr;
+        other.live = 0;
+    }
+
+    // Exchange storage with other; each arena keeps its slot table
+    void swap(NodeArena &other) {
+        blocks.swap(other.blocks);
+        std::swap(used, other.used);
+        std::swap(free_list, other.free_list);
+        std::swap(free_tail, other.free_tail);
+        std::swap(live, other.live);
+    }
+
+    NodeArena() = default;
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    ~NodeArena() {
+        release();
+    }
+
+private:
+    // Append other's slot table to ours and answer for its table id, and
+    // for those it answered for; other starts a new table
+    void adopt_handles(NodeArena &other) {
+        if (!other.slots.empty()) {
+            uint32_t offset = slots.size();
+            slots.insert(slots.end(), other.slots.begin(), other.slots.end());
+            for (uint32_t slot : other.free_slots)
+                free_slots.push_back(slot + offset);
+            for (auto [x, slot] : other.slot_of)
+                slot_of.emplace(x, slot + offset);
+            aliases.push_back({other.table, offset, uint32_t(other.slots.size())});
+            for (const Alias &alias : other.aliases)
+                aliases.push_back({alias.table, alias.offset + offset, alias.count});
+        }
+        other.reset_handles();
+    }
+
+    void release_slot(T *x) {
+        auto it = slot_of.find(x);
+        if (it == slot_of.end()) return;
+        Slot &slot = slots[it->second];
+        slot.node = nullptr;
+        slot.generation++;
+        free_slots.push_back(it->second);
+        slot_of.erase(it);
+    }
+};
+
+}
+#endif
@@ -2,6 +2,7 @@
 #define ORIGINAL_SPLAY_TREE_H
 
 #include <bits/stdc++.h>
+#include "memory_usage.h"
 using namespace std;
 
 namespace ost {
@@ -33,6 +34,7 @@ struct Node {
 
 // Splay Tree class
 struct SplayTree {
+    int size = 0;
     Node *root = nullptr;
 
     // Set a new root for the tree
@@ -69,6 +71,7 @@ struct SplayTree {
 
     // Insert a key into the tree
     void insert(int key) {
+        size++;
         Node *x = new Node();
         x->key = key;
 
@@ -103,7 +106,7 @@ struct SplayTree {
             }
         }
 
-        splay(answer);
+        if (answer) splay(answer);
         return answer;
     }
 
@@ -111,6 +114,7 @@ struct SplayTree {
     void remove(Node *x) {
         if (x == nullptr) return;
 
+        size--;
         splay(x); // Bring x to the root
         if (x->child[0]) x->child[0]->parent = nullptr;
         if (x->child[1]) x->child[1]->parent = nullptr;
@@ -118,11 +122,13 @@ struct SplayTree {
         Node *left_subtree = x->child[0];
         Node *right_subtree = x->child[1];
 
+        x->child[0] = x->child[1] = nullptr;
         delete x; // Free memory for the node
 
         if (!left_subtree) {
             set_root(right_subtree);
         } else {
+            set_root(left_subtree);
             Node *max_left = left_subtree;
             while (max_left->child[1]) {
                 max_left = max_left->child[1];
@@ -133,10 +139,30 @@ struct SplayTree {
         }
     }
 
-    // Clear the entire tree
+    // Heap bytes held by the tree; every node is a separate allocation
+    memory::Usage memory_usage() const {
+        memory::Usage usage;
+        usage.nodes = size * sizeof(Node);
+        return usage;
+    }
+
+    // Clear the entire tree. Iterative, since splaying can leave a path as
+    // deep as the tree, which the recursive Node destructor would overflow
+    // the stack on.
     void clear() {
-        delete root;
+        vector<Node *> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            Node *x = stack.back();
+            stack.pop_back();
+            for (Node *&c : x->child) {
+                if (c) stack.push_back(c);
+                c = nullptr;
+            }
+            delete x;
+        }
         root = nullptr;
+        size = 0;
     }
 
     // Destructor to clear the tree when it goes out of scope
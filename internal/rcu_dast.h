@@ -0,0 +1,338 @@
+#ifndef RCU_DAST_H
+#define RCU_DAST_H
+
+#include <bits/stdc++.h>
+#include "splay_policy.h"
+using namespace std;
+
+namespace rcu_dast {
+
+// Immutable once published: a write copies every node it would modify, so
+// a snapshot root keeps seeing the tree as it was. There are no parent
+// pointers, since those would tie a shared node to a single version.
+struct Node {
+    Node *child[2] = {nullptr, nullptr};
+    int key;
+    int size = 1;
+    long long sum = 0;
+
+    friend int get_size(const Node *x) {
+        return x == nullptr ? 0 : x->size;
+    }
+
+    friend long long get_sum(const Node *x) {
+        return x == nullptr ? 0LL : x->sum;
+    }
+
+    void join() {
+        size = get_size(child[0]) + get_size(child[1]) + 1;
+        sum = get_sum(child[0]) + get_sum(child[1]) + key;
+    }
+};
+
+// Read-only view of one version of the tree. Holding a snapshot pins its
+// epoch, so the writer does not free any node the snapshot can reach.
+class Snapshot {
+public:
+    Snapshot(const Node *root, atomic<uint64_t> *slot) : root(root), slot(slot) {}
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    Snapshot(Snapshot &&other) : root(other.root), slot(other.slot) {
+        other.slot = nullptr;
+    }
+
+    ~Snapshot() {
+        if (slot)
+            slot->store(UINT64_MAX);
+    }
+
+    int size() const {
+        return get_size(root);
+    }
+
+    // Number of keys < key
+    int order_of_key(int key) const {
+        int count = 0;
+        for (const Node *current = root; current != nullptr;) {
+            if (current->key < key) {
+                count += get_size(current->child[0]) + 1;
+                current = current->child[1];
+            } else {
+                current = current->child[0];
+            }
+        }
+        return count;
+    }
+
+    // Sum of the keys in [low, high]
+    long long range_sum(int low, int high) const {
+        if (high < low) return 0;
+        return sum_less(high == INT_MAX ? high : high + 1, high == INT_MAX) - sum_less(low, false);
+    }
+
+    // Call visit on every key in order
+    template <typename Visit>
+    void for_each(Visit visit) const {
+        vector<const Node *> stack;
+        const Node *current = root;
+
+        while (current != nullptr || !stack.empty()) {
+            while (current != nullptr) {
+                stack.push_back(current);
+                current = current->child[0];
+            }
+            current = stack.back();
+            stack.pop_back();
+            visit(current->key);
+            current = current->child[1];
+        }
+    }
+
+private:
+    const Node *root;
+    atomic<uint64_t> *slot;
+
+    // Sum of the keys < key, or <= key when inclusive
+    long long sum_less(int key, bool inclusive) const {
+        long long sum = 0;
+        for (const Node *current = root; current != nullptr;) {
+            if (current->key < key || (inclusive && current->key == key)) {
+                sum += get_sum(current->child[0]) + current->key;
+                current = current->child[1];
+            } else {
+                current = current->child[0];
+            }
+        }
+        return sum;
+    }
+};
+
+// Depth-aware splay tree with one writer and any number of snapshot
+// readers. Writes copy the root-to-node path and publish the new root
+// atomically; splaying rotates only those fresh copies, so lookups that
+// stay above the depth threshold neither copy nor publish anything.
+// Replaced nodes are retired and freed once every snapshot that was taken
+// before their retirement has been released (epoch-based reclamation).
+// insert and lower_bound must only be called from the writer thread.
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    static constexpr int MAX_READERS = 64;
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    int size = 0;
+    SplayPolicy policy;
+
+    atomic<Node *> root{nullptr};
+
+    // Number of retired nodes collected before the epoch advances
+    size_t reclaim_batch = 1024;
+
+    BasicDepthAwareSplayTree() {
+        for (auto &slot : slots)
+            slot.epoch.store(IDLE);
+    }
+
+    BasicDepthAwareSplayTree(const BasicDepthAwareSplayTree &) = delete;
+    BasicDepthAwareSplayTree &operator=(const BasicDepthAwareSplayTree &) = delete;
+
+    // Pin the current version for reading; may be called from any thread
+    Snapshot snapshot() {
+        while (true) {
+            for (auto &slot : slots) {
+                uint64_t expected = IDLE;
+                if (slot.epoch.compare_exchange_strong(expected, epoch.load())) {
+                    // The epoch is published before the root is read, so the
+                    // writer cannot free anything reachable from this root
+                    return Snapshot(root.load(), &slot.epoch);
+                }
+            }
+            this_thread::yield();
+        }
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+        policy.resize(size);
+
+        Node *x = new Node();
+        x->key = key;
+        x->sum = key;
+
+        // Record the path, then copy it bottom up with the new leaf attached
+        path.clear();
+        sides.clear();
+        for (Node *current = root.load(memory_order_relaxed); current != nullptr;) {
+            path.push_back(current);
+            sides.push_back(int(current->key < key));
+            current = current->child[sides.back()];
+        }
+
+        int depth = path.size();
+        copy_path(x);
+        if (policy.should_splay(depth, x))
+            splay();
+
+        publish();
+    }
+
+    // Find the node with the smallest key >= the given key. The node stays
+    // valid on the writer thread until the next write.
+    const Node *lower_bound(const int &key) {
+        Node *current = root.load(memory_order_relaxed);
+        Node *answer = nullptr;
+        int depth = 0, answer_depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+            if (current->key < key) {
+                current = current->child[1];
+            } else {
+                answer = current;
+                answer_depth = depth;
+                current = current->child[0];
+            }
+        }
+
+        if (answer && policy.should_splay(depth, answer)) {
+            // Re-walk to the answer and splay a copy of that path
+            path.clear();
+            sides.clear();
+            current = root.load(memory_order_relaxed);
+            for (int i = 1; i < answer_depth; i++) {
+                path.push_back(current);
+                sides.push_back(int(current->key < key));
+                current = current->child[sides.back()];
+            }
+
+            retired.push_back(answer);
+            copy_path(new Node(*answer));
+            splay();
+            publish();
+            return copies.front();
+        }
+
+        return answer;
+    }
+
+    ~BasicDepthAwareSplayTree() {
+        // No snapshot may outlive the tree, so everything can go now
+        for (auto &batch : retired_batches)
+            for (Node *x : batch.second)
+                delete x;
+        for (Node *x : retired)
+            delete x;
+
+        vector<Node *> stack;
+        if (Node *x = root.load()) stack.push_back(x);
+        while (!stack.empty()) {
+            Node *x = stack.back();
+            stack.pop_back();
+            if (x->child[0]) stack.push_back(x->child[0]);
+            if (x->child[1]) stack.push_back(x->child[1]);
+            delete x;
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        atomic<uint64_t> epoch;
+    };
+
+    Slot slots[MAX_READERS];
+    atomic<uint64_t> epoch{0};
+
+    // Writer state: the path being rewritten with the side taken at each
+    // node, its fresh copies (root first, ending with the accessed node) and
+    // the nodes replaced so far
+    vector<Node *> path;
+    vector<int> sides;
+    vector<Node *> copies;
+    vector<Node *> retired;
+    deque<pair<uint64_t, vector<Node *>>> retired_batches;
+
+    // Replace every node on path by a copy linked to the next copy, ending
+    // with x below the last path node
+    void copy_path(Node *x) {
+        copies.assign(path.size() + 1, nullptr);
+        copies.back() = x;
+        x->join();
+
+        for (int i = int(path.size()) - 1; i >= 0; i--) {
+            Node *copy = new Node(*path[i]);
+            copy->child[sides[i]] = copies[i + 1];
+            copy->join();
+            copies[i] = copy;
+            retired.push_back(path[i]);
+        }
+    }
+
+    // Rotate the child copies[i] above its parent copies[i - 1]
+    void rotate_up(int i) {
+        Node *x = copies[i], *p = copies[i - 1];
+        int index = int(p->child[1] == x);
+
+        p->child[index] = x->child[!index];
+        x->child[!index] = p;
+        p->join();
+        x->join();
+
+        if (i >= 2) {
+            Node *gp = copies[i - 2];
+            gp->child[gp->child[1] == p] = x;
+        }
+        copies[i - 1] = x;
+        copies.erase(copies.begin() + i);
+    }
+
+    // Bottom-up splay of the last copy to the top of the copied path
+    void splay() {
+        while (copies.size() > 1) {
+            int i = copies.size() - 1;
+            if (i >= 2) {
+                Node *x = copies[i], *p = copies[i - 1], *gp = copies[i - 2];
+                bool zig_zig = (p->child[1] == x) == (gp->child[1] == p);
+                if (zig_zig) {
+                    rotate_up(i - 1);
+                    rotate_up(i - 1);
+                } else {
+                    rotate_up(i);
+                    rotate_up(i - 1);
+                }
+            } else {
+                rotate_up(i);
+            }
+        }
+    }
+
+    // Make the copied path the current version and reclaim what readers
+    // can no longer reach
+    void publish() {
+        root.store(copies.front());
+
+        if (retired.size() < reclaim_batch)
+            return;
+
+        retired_batches.emplace_back(epoch.load(), std::move(retired));
+        retired.clear();
+        epoch.fetch_add(1);
+
+        uint64_t oldest = IDLE;
+        for (auto &slot : slots)
+            oldest = min(oldest, slot.epoch.load());
+
+        // A batch retired in epoch e is unreachable for readers that pinned
+        // a later epoch
+        while (!retired_batches.empty() && retired_batches.front().first < oldest) {
+            for (Node *x : retired_batches.front().second)
+                delete x;
+            retired_batches.pop_front();
+        }
+    }
+};
+
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
+}
+#endif
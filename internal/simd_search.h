@@ -0,0 +1,139 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SEARCH_X86 1
+#else
+#define SIMD_SEARCH_X86 0
+#endif
+
+// Branch-free kernels that rank a query against a small sorted key array,
+// as found in multi-key nodes. On sorted keys, count_less is the lower_bound
+// position and count_less_equal is the upper_bound position.
+namespace simd {
+
+using Kernel = int (*)(const int *, int, int);
+
+inline int count_less_scalar(const int *keys, int n, int key) {
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += keys[i] < key;
+    return count;
+}
+
+inline int count_greater_scalar(const int *keys, int n, int key) {
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += keys[i] > key;
+    return count;
+}
+
+#if SIMD_SEARCH_X86
+// Four keys per compare; 32-bit signed compares only need SSE2
+__attribute__((target("sse4.1,popcnt"))) inline int count_less_sse(const int *keys, int n, int key) {
+    __m128i query = _mm_set1_epi32(key);
+    int count = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(query, block))));
+    }
+    return count + count_less_scalar(keys + i, n - i, key);
+}
+
+__attribute__((target("sse4.1,popcnt"))) inline int count_greater_sse(const int *keys, int n, int key) {
+    __m128i query = _mm_set1_epi32(key);
+    int count = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, query))));
+    }
+    return count + count_greater_scalar(keys + i, n - i, key);
+}
+
+// Eight keys per compare
+__attribute__((target("avx2,popcnt"))) inline int count_less_avx2(const int *keys, int n, int key) {
+    __m256i query = _mm256_set1_epi32(key);
+    int count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(query, block))));
+    }
+    return count + count_less_sse(keys + i, n - i, key);
+}
+
+__attribute__((target("avx2,popcnt"))) inline int count_greater_avx2(const int *keys, int n, int key) {
+    __m256i query = _mm256_set1_epi32(key);
+    int count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, query))));
+    }
+    return count + count_greater_sse(keys + i, n - i, key);
+}
+#endif
+
+// CPU feature checks for the kernels above
+inline bool has_sse() {
+#if SIMD_SEARCH_X86
+    return __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt");
+#else
+    return false;
+#endif
+}
+
+inline bool has_avx2() {
+#if SIMD_SEARCH_X86
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#else
+    return false;
+#endif
+}
+
+// Pick the widest kernel the CPU supports
+inline Kernel select_count_less() {
+#if SIMD_SEARCH_X86
+    if (has_avx2()) return count_less_avx2;
+    if (has_sse()) return count_less_sse;
+#endif
+    return count_less_scalar;
+}
+
+inline Kernel select_count_greater() {
+#if SIMD_SEARCH_X86
+    if (has_avx2()) return count_greater_avx2;
+    if (has_sse()) return count_greater_sse;
+#endif
+    return count_greater_scalar;
+}
+
+// Number of keys < the given key. Uses the kernel enabled at compile time
+// when building with -mavx2 or -msse4.1 (plus -mpopcnt), otherwise dispatches on CPUID once.
+inline int count_less(const int *keys, int n, int key) {
+#if defined(__AVX2__) && defined(__POPCNT__)
+    return count_less_avx2(keys, n, key);
+#elif defined(__SSE4_1__) && defined(__POPCNT__)
+    return count_less_sse(keys, n, key);
+#else
+    static const Kernel kernel = select_count_less();
+    return kernel(keys, n, key);
+#endif
+}
+
+// Number of keys <= the given key
+inline int count_less_equal(const int *keys, int n, int key) {
+#if defined(__AVX2__) && defined(__POPCNT__)
+    return n - count_greater_avx2(keys, n, key);
+#elif defined(__SSE4_1__) && defined(__POPCNT__)
+    return n - count_greater_sse(keys, n, key);
+#else
+    static const Kernel kernel = select_count_greater();
+    return n - kernel(keys, n, key);
+#endif
+}
+
+}
+#endif
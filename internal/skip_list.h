@@ -0,0 +1,99 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace skip_list {
+
+constexpr int MAX_LEVEL = 24;
+
+// Node with a tower of forward links, allocated to its height
+struct Node {
+    int key;
+    int height;
+    Node *next[1];
+
+    static Node *create(int key, int height) {
+        void *memory = ::operator new(sizeof(Node) + (height - 1) * sizeof(Node *));
+        Node *x = static_cast<Node *>(memory);
+        x->key = key;
+        x->height = height;
+        fill(x->next, x->next + height, nullptr);
+        return x;
+    }
+
+    static void destroy(Node *x) {
+        ::operator delete(x);
+    }
+};
+
+// Skip list baseline for comparative benchmarks; each level keeps a node
+// with probability 1/4
+struct SkipList {
+    int size = 0;
+    int level = 1;
+    Node *head = Node::create(INT_MIN, MAX_LEVEL);
+    mt19937 gen{0};  // Fixed seed for reproducibility
+
+    int random_height() {
+        int height = 1;
+        while (height < MAX_LEVEL && (gen() & 3) == 0)
+            height++;
+        return height;
+    }
+
+    // Insert a key into the list
+    void insert(int key) {
+        size++;
+        Node *update[MAX_LEVEL];
+        Node *current = head;
+        for (int i = level - 1; i >= 0; i--) {
+            while (current->next[i] && current->next[i]->key < key)
+                current = current->next[i];
+            update[i] = current;
+        }
+
+        int height = random_height();
+        for (; level < height; level++)
+            update[level] = head;
+
+        Node *x = Node::create(key, height);
+        for (int i = 0; i < height; i++) {
+            x->next[i] = update[i]->next[i];
+            update[i]->next[i] = x;
+        }
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) const {
+        Node *current = head;
+        for (int i = level - 1; i >= 0; i--) {
+            while (current->next[i] && current->next[i]->key < key)
+                current = current->next[i];
+        }
+        Node *x = current->next[0];
+        return x ? &x->key : nullptr;
+    }
+
+    // Clear the entire list
+    void clear() {
+        for (Node *x = head->next[0]; x != nullptr;) {
+            Node *next = x->next[0];
+            Node::destroy(x);
+            x = next;
+        }
+        fill(head->next, head->next + MAX_LEVEL, nullptr);
+        level = 1;
+        size = 0;
+    }
+
+    // Destructor to clear the list when it goes out of scope
+    ~SkipList() {
+        clear();
+        Node::destroy(head);
+    }
+};
+
+}
+#endif
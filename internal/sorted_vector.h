@@ -0,0 +1,47 @@
+#ifndef SORTED_VECTOR_H
+#define SORTED_VECTOR_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace sorted_vector {
+
+// Sorted array with binary search, the baseline for read-only phases.
+// Inserts are appended and sorted in on the next lookup, so a bulk load
+// followed by lookups costs one sort.
+struct SortedVector {
+    int size = 0;
+    vector<int> keys;
+    size_t sorted = 0;  // Length of the sorted prefix of keys
+
+    // Insert a key
+    void insert(int key) {
+        size++;
+        keys.push_back(key);
+    }
+
+    // Sort the pending tail into the sorted prefix
+    void flush() {
+        if (sorted == keys.size()) return;
+        sort(keys.begin() + sorted, keys.end());
+        inplace_merge(keys.begin(), keys.begin() + sorted, keys.end());
+        sorted = keys.size();
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) {
+        flush();
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        return it == keys.end() ? nullptr : &*it;
+    }
+
+    // Clear all keys
+    void clear() {
+        keys.clear();
+        sorted = 0;
+        size = 0;
+    }
+};
+
+}
+#endif
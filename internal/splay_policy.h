@@ -0,0 +1,152 @@
+#ifndef SPLAY_POLICY_H
+#define SPLAY_POLICY_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Compile-time policies deciding whether an access restructures the tree.
+// A policy keeps a depth threshold up to date through resize(size), which
+// the trees call whenever their size changes, and answers
+// should_splay(depth, x) once per access, where depth counts the nodes
+// visited (root = 1) and x is the node the access would splay.
+namespace splay_policy {
+
+// Whether a policy keeps per-node state in the nodes' hits and epoch
+// fields; for any other policy those fields are unused node bytes
+template <typename Policy, typename = void>
+struct uses_node_counters : false_type {};
+
+template <typename Policy>
+struct uses_node_counters<Policy, enable_if_t<Policy::node_counters>> : true_type {};
+
+// Splay when depth >= floor(Coefficient * log2(size)); the default is the
+// 1.6 * log2 rule used throughout the depth-aware trees
+template <typename Coefficient = ratio<8, 5>>
+struct LogDepth {
+    int threshold = 0;
+
+    void resize(int size) {
+        threshold = size > 0 ? floor(double(Coefficient::num) / Coefficient::den * log2(size)) : 0;
+    }
+
+    template <typename Node>
+    bool should_splay(int depth, Node *) {
+        return depth >= threshold;
+    }
+};
+
+// The threshold from analysis_dast.h: twice the floor of log2(size), at least 4
+struct ClzDepth {
+    int threshold = 0;
+
+    void resize(int size) {
+        threshold = size > 0 ? max(4, (31 - __builtin_clz(size)) << 1) : 4;
+    }
+
+    template <typename Node>
+    bool should_splay(int depth, Node *) {
+        return depth >= threshold;
+    }
+};
+
+// Splay each access with probability Probability, regardless of depth
+template <typename Probability = ratio<1, 8>>
+struct Random : LogDepth<> {
+    mt19937 gen{0};  // Fixed seed for reproducibility
+
+    template <typename Node>
+    bool should_splay(int, Node *) {
+        return gen() < uint64_t(mt19937::max()) * Probability::num / Probability::den;
+    }
+};
+
+// Splay every K-th access, regardless of depth
+template <int K = 8>
+struct Periodic : LogDepth<> {
+    int accesses = 0;
+
+    template <typename Node>
+    bool should_splay(int, Node *) {
+        if (++accesses < K)
+            return false;
+        accesses = 0;
+        return true;
+    }
+};
+
+// Weigh depth by the time since the last splay: splay when
+// depth * min(accesses since last splay, Window) >= threshold * Window.
+// Right after a splay only very deep accesses restructure again, and after
+// Window quiet accesses this is the plain depth rule.
+template <int Window = 16>
+struct DepthRecency : LogDepth<> {
+    int since_splay = 0;
+
+    template <typename Node>
+    bool should_splay(int depth, Node *) {
+        since_splay = min(since_splay + 1, Window);
+        if (depth * since_splay < threshold * Window)
+            return false;
+        since_splay = 0;
+        return true;
+    }
+};
+
+// Splay a deep node only once it has been accessed MinHits times recently,
+// so a one-off scan cannot push repeatedly accessed keys out of the top of
+// the tree. Each node keeps a saturating hit counter that is halved every
+// DecayPeriod accesses; the halving is applied lazily when the node is next
+// touched. Requires nodes with hits and epoch fields (dast::Node).
+template <int MinHits = 2, int DecayPeriod = 1 << 16>
+struct Frequency : LogDepth<> {
+    static constexpr bool node_counters = true;
+
+    int accesses = 0;
+    uint8_t epoch = 0;
+
+    template <typename Node>
+    bool should_splay(int depth, Node *x) {
+        if (++accesses == DecayPeriod) {
+            accesses = 0;
+            epoch++;
+        }
+
+        uint8_t age = epoch - x->epoch;
+        x->hits = age >= 8 ? 0 : x->hits >> age;
+        x->epoch = epoch;
+        if (x->hits < UINT8_MAX)
+            x->hits++;
+
+        return depth >= threshold && x->hits >= MinHits;
+    }
+};
+
+// Wrap another policy so that splaying can be switched off for a batch of
+// accesses. While deferred, no access splays; the deepest access that the
+// wrapped policy would have splayed is remembered by key, so the batch can
+// end with a single lookup that restructures for it. Requires nodes with a
+// key field.
+template <typename Inner = LogDepth<>>
+struct Deferred : Inner {
+    bool deferred = false;
+    bool pending = false;
+    int pending_depth = 0;
+    int pending_key = 0;
+
+    template <typename Node>
+    bool should_splay(int depth, Node *x) {
+        bool splay = Inner::should_splay(depth, x);
+        if (!deferred)
+            return splay;
+
+        if (splay && depth > pending_depth) {
+            pending = true;
+            pending_depth = depth;
+            pending_key = x->key;
+        }
+        return false;
+    }
+};
+
+}
+#endif
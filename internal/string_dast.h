@@ -0,0 +1,272 @@
+#ifndef STRING_DAST_H
+#define STRING_DAST_H
+
+#include <bits/stdc++.h>
+#include "node_arena.h"
+#include "splay_policy.h"
+using namespace std;
+
+namespace string_dast {
+
+// Append-only storage for key bytes, in large blocks. Removed keys keep
+// their bytes until clear().
+struct KeyArena {
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+    vector<unique_ptr<char[]>> blocks;
+    char *next = nullptr;   // Free space in the last block
+    size_t remaining = 0;
+
+    const char *store(string_view key) {
+        if (blocks.empty() || key.size() > remaining) {
+            // Keys longer than a block get a block of their own
+            remaining = max(BLOCK_SIZE, key.size());
+            blocks.emplace_back(new char[remaining]);
+            next = blocks.back().get();
+        }
+        char *data = next;
+        memcpy(data, key.data(), key.size());
+        next += key.size();
+        remaining -= key.size();
+        return data;
+    }
+
+    void clear() {
+        blocks.clear();
+        next = nullptr;
+        remaining = 0;
+    }
+};
+
+// Node structure for the string-keyed Splay Tree. The first 8 bytes of the
+// key are cached inline as a big-endian integer, zero padded, so that most
+// comparisons near the root are decided without touching the key bytes.
+struct Node {
+    Node *parent = nullptr;
+    Node *child[2] = {nullptr, nullptr};
+    uint64_t prefix = 0;
+    const char *data = nullptr;
+    uint32_t length = 0;
+
+    string_view key() const {
+        return string_view(data, length);
+    }
+
+    // Set a child node and update its parent pointer
+    void set_child(int index, Node *child_node) {
+        child[index] = child_node;
+        if (child_node)
+            child_node->parent = this;
+    }
+
+    // Determine the index of this node relative to its parent
+    int parent_index() const {
+        return parent == nullptr ? -1 : int(this == parent->child[1]);
+    }
+};
+
+// First 8 bytes of a key as an integer that orders like the bytes
+inline uint64_t load_prefix(string_view key) {
+    uint64_t word = 0;
+    memcpy(&word, key.data(), min<size_t>(key.size(), 8));
+    return __builtin_bswap64(word);
+}
+
+// Index of the first byte in [start, n) where a and b differ, or n
+inline size_t mismatch(const char *a, const char *b, size_t start, size_t n) {
+    size_t i = start;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (x != y)
+            return i + __builtin_ctzll(x ^ y) / 8;
+    }
+    for (; i < n; i++)
+        if (a[i] != b[i]) return i;
+    return n;
+}
+
+// Depth-aware splay tree keyed by byte strings, compared lexicographically
+// as unsigned bytes. A descent keeps the longest common prefix of the
+// query with the closest smaller and larger keys seen so far; every key
+// in the current subtree shares the smaller of the two with the query, so
+// comparisons start past it instead of at byte 0.
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    int size = 0;
+    SplayPolicy policy;
+
+    Node *root = nullptr;
+    arena::NodeArena<Node> nodes;
+    KeyArena keys;
+
+    // Comparison shortcuts, both on by default; they can be turned off to
+    // measure their effect
+    bool prefix_cache = true;
+    bool skip_common_prefix = true;
+
+    // Compare key (with its cached prefix) against x's key, knowing that
+    // their first skip bytes are equal. Returns <0, 0 or >0 like memcmp,
+    // and sets lcp to the length of their common prefix.
+    int compare(string_view key, uint64_t key_prefix, const Node *x, size_t skip, size_t &lcp) const {
+        size_t n = min<size_t>(key.size(), x->length);
+
+        if (prefix_cache && skip < 8) {
+            if (key_prefix != x->prefix) {
+                lcp = min<size_t>(__builtin_clzll(key_prefix ^ x->prefix) / 8, n);
+                return key_prefix < x->prefix ? -1 : 1;
+            }
+            skip = min<size_t>(8, n);
+        }
+
+        lcp = mismatch(key.data(), x->data, skip, n);
+        if (lcp < n)
+            return (unsigned char)key[lcp] < (unsigned char)x->data[lcp] ? -1 : 1;
+        return key.size() < x->length ? -1 : key.size() > x->length ? 1 : 0;
+    }
+
+    // Set a new root for the tree
+    Node *set_root(Node *x) {
+        if (x)
+            x->parent = nullptr;
+        return root = x;
+    }
+
+    // Perform a single rotation
+    void rotate_up(Node *x) {
+        Node *p = x->parent;
+        Node *gp = p->parent;
+        int index = x->parent_index();
+
+        if (gp) {
+            gp->set_child(p->parent_index(), x);
+        } else {
+            set_root(x);
+        }
+
+        p->set_child(index, x->child[!index]);
+        x->set_child(!index, p);
+    }
+
+    // Splay operation to move a node to the root
+    void splay(Node *x) {
+        while (x != root) {
+            if (x->parent != root)
+                rotate_up(x->parent_index() == x->parent->parent_index() ? x->parent : x);
+            rotate_up(x);
+        }
+    }
+
+    // Insert a key into the tree; equal keys are kept
+    void insert(string_view key) {
+        size++;
+        policy.resize(size);
+
+        Node *x = nodes.allocate();
+        x->data = keys.store(key);
+        x->length = key.size();
+        x->prefix = load_prefix(key);
+
+        if (root == nullptr) {
+            set_root(x);
+            return;
+        }
+
+        Node *current = root, *previous = nullptr;
+        size_t low = 0, high = 0, lcp;
+        int depth = 0, side = 0;
+
+        while (current != nullptr) {
+            depth++;
+            previous = current;
+            side = int(compare(key, x->prefix, current, skip(low, high), lcp) > 0);
+            (side ? low : high) = lcp;
+            current = current->child[side];
+        }
+
+        previous->set_child(side, x);
+
+        if (policy.should_splay(depth, x))
+            splay(x);
+    }
+
+    // Find the node with the smallest key >= the given key
+    Node *lower_bound(string_view key) {
+        uint64_t key_prefix = load_prefix(key);
+        Node *current = root;
+        Node *answer = nullptr;
+        size_t low = 0, high = 0, lcp;
+        int depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+            if (compare(key, key_prefix, current, skip(low, high), lcp) > 0) {
+                low = lcp;
+                current = current->child[1];
+            } else {
+                answer = current;
+                high = lcp;
+                current = current->child[0];
+            }
+        }
+
+        if (answer && policy.should_splay(depth, answer))
+            splay(answer);
+        return answer;
+    }
+
+    // Remove a specific node
+    void remove(Node *x) {
+        if (x == nullptr) return;
+
+        size--;
+        policy.resize(size);
+        splay(x); // Bring x to the root
+
+        if (x->child[0]) x->child[0]->parent = nullptr;
+        if (x->child[1]) x->child[1]->parent = nullptr;
+
+        Node *left_subtree = x->child[0];
+        Node *right_subtree = x->child[1];
+
+        nodes.deallocate(x); // Free memory for the node
+
+        if (!left_subtree) {
+            set_root(right_subtree);
+        } else {
+            set_root(left_subtree);
+            Node *max_left = left_subtree;
+            while (max_left->child[1]) {
+                max_left = max_left->child[1];
+            }
+            splay(max_left); // Bring max of left subtree to the root
+            max_left->set_child(1, right_subtree);
+            set_root(max_left);
+        }
+    }
+
+    // Clear the entire tree
+    void clear() {
+        nodes.release();
+        keys.clear();
+        root = nullptr;
+        size = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~BasicDepthAwareSplayTree() {
+        clear();
+    }
+
+private:
+    // Bytes every key between the two bounds shares with the query
+    size_t skip(size_t low, size_t high) const {
+        return skip_common_prefix ? min(low, high) : 0;
+    }
+};
+
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
+}
+#endif
@@ -2,6 +2,10 @@
 #define SUM_QUERY_DAST_H
 
 #include <bits/stdc++.h>
+#include "memory_usage.h"
+#include "node_arena.h"
+#include "splay_policy.h"
+#include "task_pool.h"
 using namespace std;
 
 namespace sum_query_dast {
@@ -38,23 +42,28 @@ struct Node {
         size = get_size(child[0]) + get_size(child[1]) + 1;
         sum = get_sum(child[0]) + get_sum(child[1]) + key;
     }
-
-    ~Node() {
-        // Recursively delete children
-        delete child[0];
-        delete child[1];
-    }
 };
 
-struct DepthAwareSplayTree {
-    int size = 0;
-    int threshold = 0;
+// Reference to a node that stays valid until the node is removed, also
+// across set operations, which move other's nodes into this tree
+using Handle = arena::Handle;
 
-    int get_depth_threshold() {
-        return floor(1.6 * log2(size));
-    }
+// SplayPolicy decides which accesses restructure the tree (see splay_policy.h)
+template <typename SplayPolicy = splay_policy::LogDepth<>>
+struct BasicDepthAwareSplayTree {
+    int size = 0;
+    SplayPolicy policy;
 
     Node *root = nullptr;
+    arena::NodeArena<Node> nodes;
+
+    // Set operations recurse in parallel only while both inputs together
+    // hold at least this many nodes
+    int set_operation_grain = 1 << 14;
+
+    // Recursion depth past which a set operation flattens what is left and
+    // rebuilds it balanced; set from the input sizes by each operation
+    int set_operation_depth = 0;
 
     // Set a new root for the tree
     Node *set_root(Node *x) {
@@ -98,10 +107,11 @@ struct DepthAwareSplayTree {
     void insert(int key) {
         size++;
 
-        threshold = get_depth_threshold();
+        policy.resize(size);
         static Node *x;
-        x = new Node();
+        x = nodes.allocate();
         x->key = key;
+        x->sum = key;
 
         if (root == nullptr) {
             set_root(x);
@@ -111,7 +121,8 @@ struct DepthAwareSplayTree {
         static Node *current, *previous;
         current = root;
         previous = nullptr;
-        static int depth = 0;
+        static int depth;
+        depth = 0;
 
         while (current != nullptr) {
             depth++;
@@ -121,7 +132,7 @@ struct DepthAwareSplayTree {
 
         previous->set_child(int(previous->key < x->key), x);
 
-        if (depth >= threshold)
+        if (policy.should_splay(depth, x))
             splay(x);
 
         for (Node *node = x; node != nullptr; node = node->parent)
@@ -146,7 +157,7 @@ struct DepthAwareSplayTree {
             }
         }
 
-        if (depth >= threshold) splay(answer);
+        if (answer && policy.should_splay(depth, answer)) splay(answer);
         return answer;
     }
 
@@ -165,7 +176,7 @@ struct DepthAwareSplayTree {
             depth++;
 
             if (index == left_size) {
-                if (depth >= threshold) {
+                if (policy.should_splay(depth, current)) {
                     splay(current);
                 }
 
@@ -183,9 +194,27 @@ struct DepthAwareSplayTree {
         assert(false);
     }
 
+    // Number of keys < the given key, counted on the way down, since the
+    // lower bound is only at the root when the access splayed it
     int order_of_key(const int &key) {
-        auto node = lower_bound(key);
-        return get_size(node->child[0]);
+        Node *current = root;
+        Node *answer = nullptr;
+        int order = 0, depth = 0;
+
+        while (current != nullptr) {
+            depth++;
+
+            if (current->key < key) {
+                order += get_size(current->child[0]) + 1;
+                current = current->child[1];
+            } else {
+                answer = current;
+                current = current->child[0];
+            }
+        }
+
+        if (answer && policy.should_splay(depth, answer)) splay(answer);
+        return order;
     }
 
     // Remove a specific node
@@ -193,7 +222,7 @@ struct DepthAwareSplayTree {
         if (x == nullptr) return;
 
         size--;
-        threshold = get_depth_threshold();
+        policy.resize(size);
         splay(x); // Bring x to the root
 
         if (x->child[0]) x->child[0]->parent = nullptr;
@@ -202,17 +231,20 @@ struct DepthAwareSplayTree {
         Node *left_subtree = x->child[0];
         Node *right_subtree = x->child[1];
 
-        delete x; // Free memory for the node
+        x->child[0] = x->child[1] = nullptr;
+        nodes.deallocate(x); // Free memory for the node
 
         if (!left_subtree) {
             set_root(right_subtree);
         } else {
+            set_root(left_subtree);
             Node *max_left = left_subtree;
             while (max_left->child[1]) {
                 max_left = max_left->child[1];
             }
             splay(max_left); // Bring max of left subtree to the root
             max_left->set_child(1, right_subtree);
+            max_left->join();
             set_root(max_left);
         }
     }
@@ -225,23 +257,400 @@ struct DepthAwareSplayTree {
 
         if (node_right->parent != node_left) {
             rotate_up(node_right);
+            node_right->join();
         }
 
         return get_sum(node_right->child[0]);
     }
 
+    // Sum over the nodes two handles refer to; 0 if either is stale
+    long long range_sum(const Handle &left, const Handle &right) {
+        return range_sum(get(left), get(right));
+    }
+
+    // Handle to a node of this tree, or an empty handle for nullptr
+    Handle handle(Node *x) {
+        return nodes.handle(x);
+    }
+
+    // Node a handle refers to, or nullptr if it was removed since
+    Node *get(const Handle &h) const {
+        return nodes.get(h);
+    }
+
+    // Remove the node a handle refers to; returns false if it is stale
+    bool remove(const Handle &h) {
+        Node *x = get(h);
+        if (x == nullptr) return false;
+        remove(x);
+        return true;
+    }
+
+    // Merge every key of other into this tree, leaving other empty. A key of
+    // other equal to a key already here is dropped. With a pool, subtrees
+    // above set_operation_grain nodes are merged in parallel.
+    void union_with(BasicDepthAwareSplayTree &other, tasks::TaskPool *pool = nullptr) {
+        set_operation(other, pool, [&](Node *a, Node *b, Garbage &garbage) { return union_nodes(a, b, pool, garbage); });
+    }
+
+    // Keep only the keys also present in other, leaving other empty
+    void intersect_with(BasicDepthAwareSplayTree &other, tasks::TaskPool *pool = nullptr) {
+        set_operation(other, pool, [&](Node *a, Node *b, Garbage &garbage) { return intersect_nodes(a, b, pool, garbage); });
+    }
+
+    // Remove every key present in other, leaving other empty
+    void difference_with(BasicDepthAwareSplayTree &other, tasks::TaskPool *pool = nullptr) {
+        set_operation(other, pool, [&](Node *a, Node *b, Garbage &garbage) { return difference_nodes(a, b, pool, garbage); });
+    }
+
+    // Heap bytes held by the tree; slack is arena space not holding a live
+    // node, and the tables are the slots behind handles
+    memory::Usage memory_usage() const {
+        memory::Usage usage;
+        usage.nodes = nodes.live * sizeof(Node);
+        usage.slack = nodes.capacity_bytes() - usage.nodes;
+        usage.augmentation = nodes.live * (sizeof(Node::size) + sizeof(Node::sum));
+        usage.tables = nodes.handle_bytes();
+        return usage;
+    }
+
     // Clear the entire tree
     void clear() {
-        delete root;
+        nodes.release();
         root = nullptr;
         size = 0;
     }
 
     // Destructor to clear the tree when it goes out of scope
-    ~DepthAwareSplayTree() {
+    ~BasicDepthAwareSplayTree() {
         clear();
     }
+
+    // The set operations are divide and conquer over raw subtrees: split the
+    // second tree around the root of the first, recurse on both sides, and
+    // join the results under the root. The pieces are disjoint, so the two
+    // recursive calls may run on different threads. Only Node methods are
+    // used below, never the tree's rotation code. The recursion follows the
+    // shape of the first tree, which a run of sorted inserts can leave as
+    // a path, so below O(log n) levels the rest is merged in key order
+    // instead, and a deep second tree is rebuilt balanced up front. The arena is not thread
+    // safe, so dropped nodes are chained into a Garbage list per task and
+    // freed on the calling thread once the operation is done.
+
+    // Subtrees to free, linked through the parent pointers of their roots
+    struct Garbage {
+        Node *head = nullptr, *tail = nullptr;
+
+        // Queue x together with its subtree
+        void push_subtree(Node *x) {
+            if (x == nullptr) return;
+            x->parent = head;
+            head = x;
+            if (tail == nullptr) tail = x;
+        }
+
+        // Queue x alone
+        void push(Node *x) {
+            x->child[0] = x->child[1] = nullptr;
+            push_subtree(x);
+        }
+
+        // Move the nodes of other to the front of this list in O(1)
+        void splice(Garbage &other) {
+            if (other.head == nullptr) return;
+            other.tail->parent = head;
+            head = other.head;
+            if (tail == nullptr) tail = other.tail;
+            other.head = other.tail = nullptr;
+        }
+    };
+
+    template <typename Operation>
+    void set_operation(BasicDepthAwareSplayTree &other, tasks::TaskPool *pool, Operation operation) {
+        Node *a = root, *b = other.root;
+        root = other.root = nullptr;
+        other.size = 0;
+        other.policy.resize(0);
+        nodes.adopt(other.nodes);
+
+        set_operation_depth = 4 * __lg(get_size(a) + get_size(b) + 1) + 16;
+        if (height(b) > set_operation_depth) {
+            vector<Node *> sorted;
+            flatten(b, sorted);
+            b = build(sorted, 0, sorted.size());
+        }
+
+        Garbage garbage;
+        if (pool)
+            pool->run([&] { set_root(operation(a, b, garbage)); });
+        else
+            set_root(operation(a, b, garbage));
+
+        // Free the queued subtrees without recursion; a node's children
+        // are read before the free list link overwrites its parent
+        vector<Node *> stack;
+        for (Node *x = garbage.head; x != nullptr;) {
+            Node *next = x->parent;
+            stack.push_back(x);
+            while (!stack.empty()) {
+                Node *y = stack.back();
+                stack.pop_back();
+                for (Node *c : y->child)
+                    if (c) stack.push_back(c);
+                nodes.deallocate(y);
+            }
+            x = next;
+        }
+
+        size = get_size(root);
+        policy.resize(size);
+    }
+
+    // Whether a recursion on subtrees a and b should fork
+    bool fork(Node *a, Node *b, tasks::TaskPool *pool) const {
+        return pool && pool->size() > 1 && get_size(a) + get_size(b) >= set_operation_grain;
+    }
+
+    // Run left and right, in parallel if asked, each collecting its own
+    // garbage, which is then added to garbage
+    template <typename Left, typename Right>
+    void both(bool parallel, tasks::TaskPool *pool, Garbage &garbage, Left left, Right right) {
+        if (parallel) {
+            Garbage left_garbage, right_garbage;
+            pool->invoke([&] { left(left_garbage); }, [&] { right(right_garbage); });
+            garbage.splice(left_garbage);
+            garbage.splice(right_garbage);
+        } else {
+            left(garbage);
+            right(garbage);
+        }
+    }
+
+    // Detach a node from its children and parent
+    static void detach(Node *x) {
+        x->parent = x->child[0] = x->child[1] = nullptr;
+    }
+
+    // Number of levels of a subtree, without recursion
+    static int height(Node *x) {
+        int levels = 0;
+        vector<pair<Node *, int>> stack;
+        if (x) stack.push_back({x, 1});
+        while (!stack.empty()) {
+            auto [y, depth] = stack.back();
+            stack.pop_back();
+            levels = max(levels, depth);
+            for (Node *c : y->child)
+                if (c) stack.push_back({c, depth + 1});
+        }
+        return levels;
+    }
+
+    // Append the nodes of a subtree in key order, without recursion
+    static void flatten(Node *x, vector<Node *> &out) {
+        vector<Node *> stack;
+        while (x != nullptr || !stack.empty()) {
+            while (x != nullptr) {
+                stack.push_back(x);
+                x = x->child[0];
+            }
+            x = stack.back();
+            stack.pop_back();
+            out.push_back(x);
+            x = x->child[1];
+        }
+    }
+
+    // Link nodes[begin, end) into a balanced subtree and return its root
+    static Node *build(const vector<Node *> &sorted, size_t begin, size_t end) {
+        if (begin == end) return nullptr;
+        size_t middle = begin + (end - begin) / 2;
+        Node *l = build(sorted, begin, middle);
+        Node *r = build(sorted, middle + 1, end);
+        return join3(l, sorted[middle], r);
+    }
+
+    // Set operation on subtrees a and b by a merge in key order, keeping
+    // the keys only in a, only in b, or in both (one node of a per node of
+    // b), and building the result balanced
+    static Node *merge_flat(Node *a, Node *b, bool keep_a, bool keep_b, bool keep_both, Garbage &garbage) {
+        vector<Node *> as, bs, kept;
+        flatten(a, as);
+        flatten(b, bs);
+        kept.reserve(as.size() + bs.size());
+
+        size_t i = 0, j = 0;
+        while (i < as.size() || j < bs.size()) {
+            if (j == bs.size() || (i < as.size() && as[i]->key < bs[j]->key)) {
+                if (keep_a) kept.push_back(as[i]);
+                else garbage.push(as[i]);
+                i++;
+            } else if (i == as.size() || bs[j]->key < as[i]->key) {
+                if (keep_b) kept.push_back(bs[j]);
+                else garbage.push(bs[j]);
+                j++;
+            } else {
+                if (keep_both) kept.push_back(as[i]);
+                else garbage.push(as[i]);
+                garbage.push(bs[j]);
+                i++;
+                j++;
+            }
+        }
+        return build(kept, 0, kept.size());
+    }
+
+    // Join l, x and r, where every key of l is <= x's key <= every key of r
+    static Node *join3(Node *l, Node *x, Node *r) {
+        x->set_child(0, l);
+        x->set_child(1, r);
+        x->parent = nullptr;
+        x->join();
+        return x;
+    }
+
+    // Join l and r, where every key of l is <= every key of r, using the
+    // maximum of l as the new root
+    static Node *join2(Node *l, Node *r) {
+        if (l == nullptr) {
+            if (r) r->parent = nullptr;
+            return r;
+        }
+
+        l->parent = nullptr;
+        Node *max_node = l;
+        while (max_node->child[1])
+            max_node = max_node->child[1];
+
+        // Splice the maximum out and fix the augmentations above it
+        if (max_node == l) {
+            l = max_node->child[0];
+        } else {
+            Node *parent = max_node->parent;
+            parent->set_child(1, max_node->child[0]);
+            for (Node *node = parent; node != nullptr; node = node->parent)
+                node->join();
+        }
+
+        return join3(l, max_node, r);
+    }
+
+    // Split t into the keys < key and the keys > key. One node with key
+    // equal to key, if any, is returned detached as the middle element.
+    static tuple<Node *, Node *, Node *> split(Node *t, int key) {
+        Node *left = nullptr, *right = nullptr, *found = nullptr;
+        Node *left_tail = nullptr, *right_tail = nullptr;
+        vector<Node *> path;
+
+        // Hang each visited node on the left or right spine
+        while (t != nullptr) {
+            Node *next;
+            if (t->key < key) {
+                next = t->child[1];
+                if (left_tail) left_tail->set_child(1, t);
+                else left = t;
+                left_tail = t;
+            } else if (key < t->key) {
+                next = t->child[0];
+                if (right_tail) right_tail->set_child(0, t);
+                else right = t;
+                right_tail = t;
+            } else {
+                found = t;
+                break;
+            }
+            path.push_back(t);
+            t = next;
+        }
+
+        Node *rest_left = found ? found->child[0] : nullptr;
+        Node *rest_right = found ? found->child[1] : nullptr;
+        if (left_tail) left_tail->set_child(1, rest_left);
+        else left = rest_left;
+        if (right_tail) right_tail->set_child(0, rest_right);
+        else right = rest_right;
+
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+            (*it)->join();
+
+        if (left) left->parent = nullptr;
+        if (right) right->parent = nullptr;
+        if (found) {
+            detach(found);
+            found->join();
+        }
+        return {left, found, right};
+    }
+
+    Node *union_nodes(Node *a, Node *b, tasks::TaskPool *pool, Garbage &garbage, int depth = 0) {
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+        if (depth > set_operation_depth) return merge_flat(a, b, true, true, true, garbage);
+
+        bool parallel = fork(a, b, pool);
+        auto [b_left, duplicate, b_right] = split(b, a->key);
+        if (duplicate) garbage.push(duplicate);
+
+        Node *a_left = a->child[0], *a_right = a->child[1];
+        Node *left, *right;
+        both(parallel, pool, garbage,
+             [&](Garbage &g) { left = union_nodes(a_left, b_left, pool, g, depth + 1); },
+             [&](Garbage &g) { right = union_nodes(a_right, b_right, pool, g, depth + 1); });
+        return join3(left, a, right);
+    }
+
+    Node *intersect_nodes(Node *a, Node *b, tasks::TaskPool *pool, Garbage &garbage, int depth = 0) {
+        if (a == nullptr || b == nullptr) {
+            garbage.push_subtree(a);
+            garbage.push_subtree(b);
+            return nullptr;
+        }
+        if (depth > set_operation_depth) return merge_flat(a, b, false, false, true, garbage);
+
+        bool parallel = fork(a, b, pool);
+        auto [b_left, duplicate, b_right] = split(b, a->key);
+
+        Node *a_left = a->child[0], *a_right = a->child[1];
+        Node *left, *right;
+        both(parallel, pool, garbage,
+             [&](Garbage &g) { left = intersect_nodes(a_left, b_left, pool, g, depth + 1); },
+             [&](Garbage &g) { right = intersect_nodes(a_right, b_right, pool, g, depth + 1); });
+
+        if (duplicate) {
+            garbage.push(duplicate);
+            return join3(left, a, right);
+        }
+        garbage.push(a);
+        return join2(left, right);
+    }
+
+    Node *difference_nodes(Node *a, Node *b, tasks::TaskPool *pool, Garbage &garbage, int depth = 0) {
+        if (a == nullptr || b == nullptr) {
+            garbage.push_subtree(b);
+            if (a) a->parent = nullptr;
+            return a;
+        }
+        if (depth > set_operation_depth) return merge_flat(a, b, true, false, false, garbage);
+
+        bool parallel = fork(a, b, pool);
+        auto [b_left, duplicate, b_right] = split(b, a->key);
+
+        Node *a_left = a->child[0], *a_right = a->child[1];
+        Node *left, *right;
+        both(parallel, pool, garbage,
+             [&](Garbage &g) { left = difference_nodes(a_left, b_left, pool, g, depth + 1); },
+             [&](Garbage &g) { right = difference_nodes(a_right, b_right, pool, g, depth + 1); });
+
+        if (duplicate) {
+            garbage.push(duplicate);
+            garbage.push(a);
+            return join2(left, right);
+        }
+        return join3(left, a, right);
+    }
 };
 
+using DepthAwareSplayTree = BasicDepthAwareSplayTree<>;
+
 }
 #endif
\ No newline at end of file
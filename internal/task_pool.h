@@ -0,0 +1,181 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace tasks {
+
+// A forked task: the closure plus a flag the forking thread waits on
+struct Task {
+    function<void()> body;
+    atomic<bool> done{false};
+};
+
+// Fork-join pool with work stealing. Each participant owns a deque: forks
+// push to the back and are popped back by the owner (LIFO, so the owner
+// keeps working on the most recent, smallest piece), while idle
+// participants steal from the front of other deques. The thread calling
+// run() takes part as participant 0, so a pool of one thread has no helper
+// threads and invoke() runs both halves inline.
+class TaskPool {
+public:
+    explicit TaskPool(int num_threads = thread::hardware_concurrency()) {
+        num_threads = max(1, num_threads);
+        for (int i = 0; i < num_threads; i++)
+            queues.push_back(make_unique<Queue>());
+        for (int i = 1; i < num_threads; i++)
+            helpers.emplace_back([this, i] { work(i); });
+    }
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    ~TaskPool() {
+        {
+            lock_guard<mutex> lock(state_mutex);
+            stopping = true;
+        }
+        state_changed.notify_all();
+        for (auto &helper : helpers)
+            helper.join();
+    }
+
+    int size() const {
+        return queues.size();
+    }
+
+    // Run root on the calling thread with the helpers stealing its forks
+    template <typename F>
+    void run(F root) {
+        {
+            lock_guard<mutex> lock(state_mutex);
+            running = true;
+        }
+        state_changed.notify_all();
+
+        int previous = current_index();
+        current_index() = 0;
+        root();
+        current_index() = previous;
+
+        lock_guard<mutex> lock(state_mutex);
+        running = false;
+    }
+
+    // Run a and b, possibly in parallel, and return once both are done.
+    // Must be called from inside run() or from a task.
+    template <typename A, typename B>
+    void invoke(A a, B b) {
+        int index = current_index();
+        if (size() == 1 || index < 0) {
+            a();
+            b();
+            return;
+        }
+
+        Task task;
+        task.body = b;
+        push(index, &task);
+        a();
+
+        // Take b back unless someone stole it, then help until it is done
+        if (pop_if(index, &task)) {
+            task.body();
+            return;
+        }
+        while (!task.done.load(memory_order_acquire)) {
+            if (Task *other = find_task(index))
+                execute(other);
+            else
+                this_thread::yield();
+        }
+    }
+
+private:
+    struct Queue {
+        mutex lock;
+        deque<Task *> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> helpers;
+
+    mutex state_mutex;
+    condition_variable state_changed;
+    bool running = false;
+    bool stopping = false;
+
+    // Participant index of the calling thread in this pool, -1 outside it
+    static int &current_index() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    void push(int index, Task *task) {
+        lock_guard<mutex> lock(queues[index]->lock);
+        queues[index]->tasks.push_back(task);
+    }
+
+    // Pop the back of our own deque if it is the given task
+    bool pop_if(int index, Task *task) {
+        lock_guard<mutex> lock(queues[index]->lock);
+        auto &tasks = queues[index]->tasks;
+        if (tasks.empty() || tasks.back() != task)
+            return false;
+        tasks.pop_back();
+        return true;
+    }
+
+    // Newest task of our own deque, else the oldest task of another one
+    Task *find_task(int index) {
+        {
+            lock_guard<mutex> lock(queues[index]->lock);
+            auto &tasks = queues[index]->tasks;
+            if (!tasks.empty()) {
+                Task *task = tasks.back();
+                tasks.pop_back();
+                return task;
+            }
+        }
+
+        for (int offset = 1; offset < size(); offset++) {
+            Queue &victim = *queues[(index + offset) % size()];
+            lock_guard<mutex> lock(victim.lock);
+            if (!victim.tasks.empty()) {
+                Task *task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return task;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static void execute(Task *task) {
+        task->body();
+        task->done.store(true, memory_order_release);
+    }
+
+    // Helper loop: steal while a run() is in progress, sleep otherwise
+    void work(int index) {
+        current_index() = index;
+
+        while (true) {
+            {
+                unique_lock<mutex> lock(state_mutex);
+                state_changed.wait(lock, [this] { return running || stopping; });
+                if (stopping)
+                    return;
+            }
+
+            if (Task *task = find_task(index))
+                execute(task);
+            else
+                this_thread::yield();
+        }
+    }
+};
+
+}
+#endif
@@ -6,6 +6,9 @@
 #include <unordered_set>
 #include <algorithm>  // For std::shuffle
 #include <utility>    // For std::pair
+#include <fstream>
+#include <sstream>
+#include <string>
 
 namespace test {
 // Define TestType as a vector of pairs representing operations and values.
@@ -81,5 +84,71 @@ TestType generateCacheAccessTest(int testSize, int subsetSize, int numAccess) {
     return testData;
 }
 
+// Operation 2: find issued by a sequential scan, reported separately from
+// the hot-set finds (operation 1)
+TestType generateHotSetScanTest(int testSize, int subsetSize, int numAccess, double scanShare) {
+    TestType testData;
+    std::mt19937 gen(0);  // Fixed seed
+    std::uniform_int_distribution<> dist(0, testSize - 1);
+    std::bernoulli_distribution isScan(scanShare);
+
+    // Insert all elements in random order initially
+    for (int i = 0; i < testSize; i++) {
+        testData.emplace_back(0, i);  // Operation 0: insert
+    }
+    std::shuffle(testData.begin(), testData.end(), gen);  // Shuffle insertions
+
+    // Create a subset of unique elements to be accessed repeatedly
+    std::unordered_set<int> uniqueSubset;
+    while ((int)uniqueSubset.size() < subsetSize) {
+        uniqueSubset.insert(dist(gen));
+    }
+    std::vector<int> subsetVector(uniqueSubset.begin(), uniqueSubset.end());
+
+    // Interleave hot-set finds with a scan that walks every key in order
+    int scanPosition = 0;
+    for (int i = 0; i < numAccess; i++) {
+        if (isScan(gen)) {
+            testData.emplace_back(2, scanPosition);  // Operation 2: scan find
+            scanPosition = (scanPosition + 1) % testSize;
+        } else {
+            int value = subsetVector[dist(gen) % subsetSize];
+            testData.emplace_back(1, value);  // Operation 1: find
+        }
+    }
+
+    return testData;
+}
+
+// Recorded traces are text files with one "operation key" pair per line,
+// using the operation codes above and 3 for remove; blank lines and lines starting with '#'
+// are ignored. Returns false if the file cannot be read or a line is malformed.
+bool readTrace(const std::string& filename, TestType& testData) {
+    std::ifstream file(filename);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        int operation, key;
+        if (!(fields >> operation >> key)) return false;
+        testData.emplace_back(operation, key);
+    }
+
+    return true;
+}
+
+bool writeTrace(const TestType& testData, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) return false;
+
+    for (const auto& q : testData) {
+        file << q.first << " " << q.second << "\n";
+    }
+
+    return bool(file);
+}
+
 }
 #endif // TEST_GEN_H
@@ -0,0 +1,87 @@
+#ifndef TREAP_H
+#define TREAP_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+namespace treap {
+
+// Node structure for the treap: a binary search tree on key and a heap on
+// a random priority
+struct Node {
+    Node *child[2] = {nullptr, nullptr};
+    int key;
+    uint32_t priority;
+};
+
+// Treap baseline for comparative benchmarks
+struct Treap {
+    int size = 0;
+    Node *root = nullptr;
+    mt19937 gen{0};  // Fixed seed for reproducibility
+
+    // Rotate the given child of *x above x
+    static void rotate(Node *&x, int index) {
+        Node *c = x->child[index];
+        x->child[index] = c->child[!index];
+        c->child[!index] = x;
+        x = c;
+    }
+
+    void insert(Node *&x, Node *node) {
+        if (x == nullptr) {
+            x = node;
+            return;
+        }
+
+        int index = int(x->key < node->key);
+        insert(x->child[index], node);
+        if (x->child[index]->priority > x->priority)
+            rotate(x, index);
+    }
+
+    // Insert a key into the tree
+    void insert(int key) {
+        size++;
+        Node *x = new Node();
+        x->key = key;
+        x->priority = gen();
+        insert(root, x);
+    }
+
+    // Find the smallest key >= the given key
+    const int *lower_bound(const int &key) const {
+        const int *answer = nullptr;
+        for (Node *current = root; current != nullptr;) {
+            if (current->key < key) {
+                current = current->child[1];
+            } else {
+                answer = &current->key;
+                current = current->child[0];
+            }
+        }
+        return answer;
+    }
+
+    static void destroy(Node *x) {
+        if (x == nullptr) return;
+        destroy(x->child[0]);
+        destroy(x->child[1]);
+        delete x;
+    }
+
+    // Clear the entire tree
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        size = 0;
+    }
+
+    // Destructor to clear the tree when it goes out of scope
+    ~Treap() {
+        clear();
+    }
+};
+
+}
+#endif
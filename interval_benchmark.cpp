@@ -0,0 +1,205 @@
+#include "bits/stdc++.h"
+#include "internal/interval_dast.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Intervals sorted by start, answered by binary search on start and a
+// backward scan bounded by the longest interval
+struct SortedVectorSweep {
+    vector<pair<int, int>> intervals;
+    int max_length = 0;
+
+    explicit SortedVectorSweep(vector<pair<int, int>> data) : intervals(std::move(data)) {
+        sort(intervals.begin(), intervals.end());
+        for (const auto& interval : intervals)
+            max_length = max(max_length, interval.second - interval.first);
+    }
+
+    // Number of intervals containing t
+    int stab(int t) const {
+        auto it = upper_bound(intervals.begin(), intervals.end(), make_pair(t, INT_MAX));
+        int count = 0;
+        while (it != intervals.begin()) {
+            --it;
+            if (it->first < t - max_length) break;
+            count += t <= it->second;
+        }
+        return count;
+    }
+
+    // Whether any interval overlaps [low, high]
+    bool overlap(int low, int high) const {
+        auto it = upper_bound(intervals.begin(), intervals.end(), make_pair(high, INT_MAX));
+        while (it != intervals.begin()) {
+            --it;
+            if (it->first < low - max_length) break;
+            if (low <= it->second) return true;
+        }
+        return false;
+    }
+};
+
+// Check every interval on every query
+struct NaiveScan {
+    vector<pair<int, int>> intervals;
+
+    int stab(int t) const {
+        int count = 0;
+        for (const auto& interval : intervals)
+            count += interval.first <= t && t <= interval.second;
+        return count;
+    }
+
+    bool overlap(int low, int high) const {
+        for (const auto& interval : intervals)
+            if (interval.first <= high && low <= interval.second) return true;
+        return false;
+    }
+};
+
+// Average time in microseconds of a query over all points; each query is
+// also recorded in histogram
+template <typename Query>
+double timeQueries(const vector<int>& points, Query query, long long& checksum, latency::Histogram& histogram) {
+    double total = 0;
+    for (int point : points) {
+        auto start = high_resolution_clock::now();
+        checksum += query(point);
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(end - start);
+    }
+    return total / points.size() * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numQueries = 1000;
+    int maxLength = 1000;
+    vector<int> testSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "DAST(stab)", "SortedVector(stab)", "NaiveScan(stab)",
+                              "DAST(overlap)", "SortedVector(overlap)", "NaiveScan(overlap)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    mt19937 gen(0);  // Fixed seed for reproducibility
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        // Random starts spread so that a point hits a handful of intervals
+        int span = testSize * 10;
+        uniform_int_distribution<int> startDist(0, span), lengthDist(0, maxLength);
+        vector<pair<int, int>> intervals(testSize);
+        for (auto& interval : intervals) {
+            interval.first = startDist(gen);
+            interval.second = interval.first + lengthDist(gen);
+        }
+
+        vector<int> points(numQueries);
+        for (int& point : points) point = startDist(gen);
+
+        interval_dast::DepthAwareSplayTree dastTree;
+        for (const auto& interval : intervals)
+            dastTree.insert(interval.first, interval.second);
+        SortedVectorSweep sweep(intervals);
+        NaiveScan naive{intervals};
+
+        // Checksums keep the queries from being optimized away and must agree
+        long long dastStabSum = 0, sweepStabSum = 0, naiveStabSum = 0;
+        long long dastOverlapSum = 0, sweepOverlapSum = 0, naiveOverlapSum = 0;
+        int width = maxLength / 10;
+
+        // One histogram per column, in column order
+        vector<latency::Histogram> histograms(columns.size() - 1);
+
+        vector<double> row = {(double)testSize};
+        row.push_back(timeQueries(points, [&](int t) {
+            int count = 0;
+            dastTree.stab(t, [&](interval_dast::Node*) { count++; });
+            return count;
+        }, dastStabSum, histograms[0]));
+        row.push_back(timeQueries(points, [&](int t) { return sweep.stab(t); }, sweepStabSum, histograms[1]));
+        row.push_back(timeQueries(points, [&](int t) { return naive.stab(t); }, naiveStabSum, histograms[2]));
+        row.push_back(timeQueries(points, [&](int t) { return dastTree.overlap(t, t + width) != nullptr; }, dastOverlapSum, histograms[3]));
+        row.push_back(timeQueries(points, [&](int t) { return sweep.overlap(t, t + width); }, sweepOverlapSum, histograms[4]));
+        row.push_back(timeQueries(points, [&](int t) { return naive.overlap(t, t + width); }, naiveOverlapSum, histograms[5]));
+
+        if (dastStabSum != sweepStabSum || dastStabSum != naiveStabSum ||
+            dastOverlapSum != sweepOverlapSum || dastOverlapSum != naiveOverlapSum) {
+            cerr << "Error: query results disagree at size " << testSize << endl;
+            return 1;
+        }
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i];
+        cout << endl;
+
+        // Flag tail regressions against the sorted-vector sweep
+        regressed |= latency::compare_tail(columns[1], histograms[0], columns[2], histograms[1]);
+        regressed |= latency::compare_tail(columns[4], histograms[3], columns[5], histograms[4]);
+
+        // Store results for CSV
+        results.push_back(row);
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto& histogram : histograms) {
+            auto summary = histogram.summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/interval_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/interval_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
@@ -0,0 +1,140 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// How the key ranges of the two queues relate
+enum class Layout { Disjoint, Overlapping, Blocks };
+
+// Keys of the two queues: disjoint ranges; interleaved (even and odd) so
+// that every key of one falls between keys of the other; or overlapping
+// ranges made of 16 alternating blocks, as when merging batches that each
+// cover a stretch of the key space
+pair<vector<int>, vector<int>> generateKeys(int size, Layout layout) {
+    vector<int> first, second;
+    int block = max(1, size / 16);
+    for (int i = 0; i < size; i++) {
+        if (layout == Layout::Disjoint) {
+            first.push_back(i);
+            second.push_back(size + i);
+        } else if (layout == Layout::Overlapping) {
+            first.push_back(2 * i);
+            second.push_back(2 * i + 1);
+        } else {
+            int start = 2 * block * (i / block) + i % block;
+            first.push_back(start);
+            second.push_back(start + block);
+        }
+    }
+
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    shuffle(first.begin(), first.end(), gen);
+    shuffle(second.begin(), second.end(), gen);
+    return {first, second};
+}
+
+// Build both queues untimed, then time moving every key of the second
+// into the first; returns milliseconds
+template <typename Tree, typename Merge>
+double measureMerge(const pair<vector<int>, vector<int>>& keys, Merge merge) {
+    Tree first, second;
+    for (int key : keys.first) first.insert(key);
+    for (int key : keys.second) second.insert(key);
+
+    auto start = high_resolution_clock::now();
+    merge(first, second);
+    auto end = high_resolution_clock::now();
+    return duration_cast<duration<double>>(end - start).count() * 1e3;
+}
+
+void dastMeld(dast::DepthAwareSplayTree& first, dast::DepthAwareSplayTree& second) {
+    first.meld(second);
+}
+
+// The alternative to meld: insert the keys one by one, then free the
+// emptied queue
+void dastReinsert(dast::DepthAwareSplayTree& first, dast::DepthAwareSplayTree& second) {
+    vector<dast::Node*> order;
+    dast::DepthAwareSplayTree::flatten(second.root, order);
+    for (dast::Node* x : order) first.insert(x->key);
+    second.clear();
+}
+
+// std::multiset::merge relinks the nodes of the source, one insert each
+void setMerge(multiset<int>& first, multiset<int>& second) {
+    first.merge(second);
+}
+
+int main() {
+    // Test parameters
+    vector<int> testSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results;
+
+    // Column headers
+    vector<string> columns = {"QueueSize", "Meld(disjoint)", "Reinsert(disjoint)", "multiset::merge(disjoint)",
+                              "Meld(overlapping)", "Reinsert(overlapping)", "multiset::merge(overlapping)",
+                              "Meld(blocks)", "Reinsert(blocks)", "multiset::merge(blocks)"};
+
+    for (int testSize : testSizes) {
+        cout << "Testing queue size: " << testSize << endl;
+
+        vector<double> row = {(double)testSize};
+        for (Layout layout : {Layout::Disjoint, Layout::Overlapping, Layout::Blocks}) {
+            auto keys = generateKeys(testSize, layout);
+            double meldTime = measureMerge<dast::DepthAwareSplayTree>(keys, dastMeld);
+            double reinsertTime = measureMerge<dast::DepthAwareSplayTree>(keys, dastReinsert);
+            double setTime = measureMerge<multiset<int>>(keys, setMerge);
+
+            cout << (layout == Layout::Disjoint ? "Disjoint" : layout == Layout::Overlapping ? "Overlapping" : "Blocks")
+                 << ", Meld: " << meldTime << "ms"
+                 << ", Reinsert: " << reinsertTime << "ms"
+                 << ", multiset::merge: " << setTime << "ms" << endl;
+
+            row.insert(row.end(), {meldTime, reinsertTime, setTime});
+        }
+
+        // Store results for CSV
+        results.push_back(row);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/meld_benchmark/results.csv");
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "bits/stdc++.h"
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/dast_index.h"
+#include "internal/sum_query_dast.h"
+#include "internal/original_splay_tree.h"
+#include "internal/memory_counter.h"
+
+using namespace __gnu_pbds;
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+typedef tree<int, null_type, less<int>, rb_tree_tag, tree_order_statistics_node_update> ordered_set;
+
+// Distinct keys in scrambled order: multiplying by an odd constant is a
+// bijection on 32-bit integers
+int keyAt(int i) {
+    return int(uint32_t(i) * 2654435761u);
+}
+
+// Resident set size of the process in bytes
+double residentBytes() {
+    ifstream statm("/proc/self/statm");
+    size_t totalPages = 0, residentPages = 0;
+    statm >> totalPages >> residentPages;
+    return double(residentPages) * sysconf(_SC_PAGESIZE);
+}
+
+// Bytes the tree reports for itself, where it can
+template <typename Tree>
+auto reportedBytes(const Tree& tree, int) -> decltype(tree.memory_usage().total(), double()) {
+    return tree.memory_usage().total();
+}
+
+template <typename Tree>
+double reportedBytes(const Tree&, long) {
+    return NAN;
+}
+
+struct Footprint {
+    double counted;   // Live heap bytes per key from the counting allocator
+    double reported;  // memory_usage() bytes per key
+    double resident;  // Resident set growth per key
+};
+
+// Build a tree of the given size and measure its footprint
+template <typename Tree>
+Footprint measure(int testSize) {
+    malloc_trim(0);  // Return freed memory so the resident size starts low
+    size_t before = memory::current_bytes();
+    double residentBefore = residentBytes();
+
+    auto tree = make_unique<Tree>();
+    for (int i = 0; i < testSize; i++) tree->insert(keyAt(i));
+
+    Footprint footprint;
+    footprint.counted = double(memory::current_bytes() - before) / testSize;
+    footprint.resident = (residentBytes() - residentBefore) / testSize;
+    footprint.reported = reportedBytes(*tree, 0) / testSize;
+    return footprint;
+}
+
+int main() {
+    // Test parameters
+    vector<int> testSizes = {1000, 16000, 256000, 1000000, 4000000, 16000000, 64000000};
+
+    // Result storage
+    vector<vector<double>> results;
+
+    // Column headers (bytes per key)
+    vector<string> names = {"DepthAwareSplayTree", "DastIndex", "SumQueryDAST", "SplayTree", "std::set", "PBDS"};
+    vector<string> columns = {"TreeSize"};
+    for (const auto& name : names) columns.push_back(name + "(counted)");
+    for (const auto& name : names) columns.push_back(name + "(resident)");
+    for (int i = 0; i < 4; i++) columns.push_back(names[i] + "(reported)");
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        // One tree at a time, so the largest sizes fit in memory
+        vector<Footprint> footprints = {
+            measure<dast::DepthAwareSplayTree>(testSize),
+            measure<dast_index::DepthAwareSplayTree>(testSize),
+            measure<sum_query_dast::DepthAwareSplayTree>(testSize),
+            measure<ost::SplayTree>(testSize),
+            measure<set<int>>(testSize),
+            measure<ordered_set>(testSize),
+        };
+
+        vector<double> row = {(double)testSize};
+        for (const auto& footprint : footprints) row.push_back(footprint.counted);
+        for (const auto& footprint : footprints) row.push_back(footprint.resident);
+        for (int i = 0; i < 4; i++) row.push_back(footprints[i].reported);
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i];
+        cout << endl;
+
+        // Store results for CSV
+        results.push_back(row);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/memory_benchmark/results.csv");
+
+    return 0;
+}
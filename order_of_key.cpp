@@ -3,6 +3,7 @@
 #include "internal/depth_aware_splay_tree.h"
 #include "internal/dast_index.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 #include <ext/pb_ds/assoc_container.hpp>
 #include <ext/pb_ds/tree_policy.hpp>
 
@@ -45,7 +46,7 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     dast_index::DepthAwareSplayTree dast;
     ordered_set os;
 
@@ -57,11 +58,19 @@ int main() {
         testSizes.push_back(i);
 
     // Result storage
-    vector<vector<double>> results;
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
 
     // Column headers
     vector<string> columns = {"TreeSize", "PBDS", "DepthAwareSplayTree"};
 
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"PBDS", "DepthAwareSplayTree"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
     for (int testSize : testSizes) {
         cout << "Testing tree size: " << testSize << endl;
 
@@ -82,6 +91,7 @@ int main() {
 
         // Measure time for each tree
         double pbdsResult = 0, dastResult = 0;
+        latency::Histogram pbdsLatency, dastLatency;
         auto start = high_resolution_clock::now();
         auto end = high_resolution_clock::now();
         for (const auto& q : testData) {
@@ -91,12 +101,14 @@ int main() {
                 os.order_of_key(q.second);
                 end = high_resolution_clock::now();
                 pbdsResult += duration_cast<duration<double>>(end - start).count();
+                pbdsLatency.record(end - start);
 
                 // Measure Depth-Aware Splay Tree
                 start = high_resolution_clock::now();
                 dast.order_of_key(q.second);
                 end = high_resolution_clock::now();
                 dastResult += duration_cast<duration<double>>(end - start).count();
+                dastLatency.record(end - start);
             }
         }
 
@@ -109,12 +121,23 @@ int main() {
              << ", Policy Based Data Structure: " << avgPbdsTime << "us"
              << ", Depth-Aware Splay Tree: " << avgDastTime << "us" << endl;
 
+        // Flag tail regressions of the depth-aware tree
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "PBDS", pbdsLatency);
+
         // Store results for CSV
         results.push_back({(double)testSize, avgPbdsTime, avgDastTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&pbdsLatency, &dastLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
     }
 
     // Write results to CSV
     writeCSV(results, columns, "output/order_of_key/results_log.csv");
+    writeCSV(latencies, latencyColumns, "output/order_of_key/latency_log.csv");
 
-    return 0;
+    return latency::compare_mode(argc, argv) && regressed;
 }
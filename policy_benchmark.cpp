@@ -0,0 +1,132 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/splay_policy.h"
+#include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Average lookup time in microseconds for a tree with the given splay
+// policy; each lookup is also recorded in histogram
+template <typename SplayPolicy>
+double runWorkload(const test::TestType& testData, latency::Histogram& histogram) {
+    dast::BasicDepthAwareSplayTree<SplayPolicy> dastTree;
+    double total = 0;
+    int count = 0;
+
+    for (const auto& q : testData) {
+        if (q.first == 0) {
+            dastTree.insert(q.second);
+        } else {
+            auto start = high_resolution_clock::now();
+            dastTree.lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            total += duration_cast<duration<double>>(end - start).count();
+            histogram.record(end - start);
+            count++;
+        }
+    }
+
+    return total / count * 1e6;
+}
+
+int main() {
+    // Test parameters
+    vector<int> testSizes = {10000, 100000, 1000000};
+    vector<string> workloads = {"random", "cache", "gradual"};
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "LogDepth(1.6)", "ClzDepth", "Random(1/8)", "Periodic(8)", "DepthRecency(16)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (const string& workload : workloads) {
+        // Result storage
+        vector<vector<double>> results, latencies;
+
+        for (int testSize : testSizes) {
+            cout << "Testing " << workload << " workload, tree size: " << testSize << endl;
+
+            // Generate test data
+            test::TestType testData;
+            if (workload == "random") {
+                testData = test::generateTestData(testSize, 2000000);
+            } else if (workload == "cache") {
+                testData = test::generateCacheAccessTest(testSize, 1000, 2000000);
+            } else {
+                testData = test::generateGradualAccessTest(testSize, 2000000 / testSize);
+            }
+
+            vector<latency::Histogram> histograms(columns.size() - 1);
+            vector<double> row = {
+                (double)testSize,
+                runWorkload<splay_policy::LogDepth<>>(testData, histograms[0]),
+                runWorkload<splay_policy::ClzDepth>(testData, histograms[1]),
+                runWorkload<splay_policy::Random<>>(testData, histograms[2]),
+                runWorkload<splay_policy::Periodic<>>(testData, histograms[3]),
+                runWorkload<splay_policy::DepthRecency<>>(testData, histograms[4]),
+            };
+
+            // Print results for the current tree size
+            cout << "Test Size: " << testSize;
+            for (size_t i = 1; i < row.size(); i++)
+                cout << ", " << columns[i] << ": " << row[i] << "us";
+            cout << endl;
+
+            // Store results for CSV
+            results.push_back(row);
+
+            vector<double> latencyRow = {(double)testSize};
+            for (const auto& histogram : histograms) {
+                auto summary = histogram.summary();
+                latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+            }
+            latencies.push_back(latencyRow);
+        }
+
+        // Write results to CSV
+        writeCSV(results, columns, "output/policy_benchmark/" + workload + ".csv");
+        writeCSV(latencies, latencyColumns, "output/policy_benchmark/" + workload + "_latency.csv");
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Time every lookup in testData on one tree; returns the total seconds and
+// records each lookup in histogram
+double measureLookups(dast::DepthAwareSplayTree& dastTree, const test::TestType& testData, latency::Histogram& histogram) {
+    double total = 0;
+
+    for (const auto& q : testData) {
+        if (q.first == 1) {
+            auto start = high_resolution_clock::now();
+            dastTree.lower_bound(q.second);
+            auto end = high_resolution_clock::now();
+            total += duration_cast<duration<double>>(end - start).count();
+            histogram.record(end - start);
+        }
+    }
+
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    dast::DepthAwareSplayTree dastTree, prefetchTree;
+    prefetchTree.prefetch = true;
+
+    // Test parameters
+    int numAccess = 2000000;
+    vector<int> testSizes;
+    for (int i = 1 << 10; i <= (1 << 24); i *= 4)
+        testSizes.push_back(i);
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize", "DepthAwareSplayTree", "DepthAwareSplayTree(prefetch)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"DepthAwareSplayTree", "DepthAwareSplayTree(prefetch)"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+
+        // Generate test data
+        auto testData = test::generateTestData(testSize, numAccess);
+
+        // Clear previous tree data
+        dastTree.clear();
+        prefetchTree.clear();
+
+        // Insert phase
+        for (const auto& q : testData) {
+            if (q.first == 0) {
+                dastTree.insert(q.second);
+                prefetchTree.insert(q.second);
+            }
+        }
+
+        // Measure each tree in its own pass over the queries, so that one
+        // lookup never runs right after the other tree warmed the caches
+        // for the same key. The passes run in the order dast, prefetch,
+        // prefetch, dast, which gives both trees one first and one second
+        // pass over the same splayed shapes.
+        double dastResult = 0, prefetchResult = 0;
+        latency::Histogram dastLatency, prefetchLatency;
+
+        dastResult += measureLookups(dastTree, testData, dastLatency);
+        prefetchResult += measureLookups(prefetchTree, testData, prefetchLatency);
+        prefetchResult += measureLookups(prefetchTree, testData, prefetchLatency);
+        dastResult += measureLookups(dastTree, testData, dastLatency);
+
+        // Average times (convert to microseconds)
+        double avgDastTime = (dastResult / (2.0 * numAccess)) * 1e6;
+        double avgPrefetchTime = (prefetchResult / (2.0 * numAccess)) * 1e6;
+
+        // Print results for the current tree size
+        cout << "Test Size: " << testSize
+             << ", Depth-Aware Splay Tree: " << avgDastTime << "us"
+             << ", With prefetch: " << avgPrefetchTime << "us" << endl;
+
+        // Flag a tail regression caused by prefetching
+        regressed |= latency::compare_tail("DepthAwareSplayTree(prefetch)", prefetchLatency, "DepthAwareSplayTree", dastLatency);
+
+        // Store results for CSV
+        results.push_back({(double)testSize, avgDastTime, avgPrefetchTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&dastLatency, &prefetchLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/prefetch_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/prefetch_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
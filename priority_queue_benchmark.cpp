@@ -0,0 +1,189 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Timer queue workloads, in the classic hold model: the queue holds
+// queueSize pending deadlines, and each step fires the earliest one and
+// schedules a new timer at that time plus a random delay
+struct Workload {
+    vector<int> initial;     // Deadlines pending at the start
+    vector<int> delays;      // Delay of the timer scheduled by each step
+    vector<int> probes;      // Timers picked for rescheduling, modulo the queue size
+    vector<int> reductions;  // How much earlier each picked timer fires
+};
+
+Workload generateWorkload(int queueSize, int numSteps) {
+    Workload workload;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    uniform_int_distribution<> delay(1, 2 * queueSize);
+
+    for (int i = 0; i < queueSize; i++) workload.initial.push_back(delay(gen));
+    for (int i = 0; i < numSteps; i++) workload.delays.push_back(delay(gen));
+    for (int i = 0; i < numSteps; i++) workload.probes.push_back(delay(gen));
+    for (int i = 0; i < numSteps; i++) workload.reductions.push_back(delay(gen) / 4);
+    return workload;
+}
+
+// Average time per hold step in microseconds; pop returns the earliest
+// deadline and push schedules a new one. Each step is also recorded in
+// histogram.
+template <typename Pop, typename Push>
+double measureHold(const Workload& workload, Pop pop, Push push, latency::Histogram& histogram) {
+    double total = 0;
+    for (int delay : workload.delays) {
+        auto start = high_resolution_clock::now();
+        int now = pop();
+        push(now + delay);
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(end - start);
+    }
+    return total / workload.delays.size() * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numSteps = 1000000;
+    vector<int> queueSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"QueueSize", "priority_queue(hold)", "multiset(hold)", "DepthAwareSplayTree(hold)",
+                              "multiset(reschedule)", "DepthAwareSplayTree(reschedule)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"QueueSize"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int queueSize : queueSizes) {
+        cout << "Testing queue size: " << queueSize << endl;
+
+        auto workload = generateWorkload(queueSize, numSteps);
+
+        latency::Histogram heapLatency, setLatency, dastLatency, setRescheduleLatency, dastRescheduleLatency;
+
+        // Hold steps
+        priority_queue<int, vector<int>, greater<int>> heap(greater<int>(), workload.initial);
+        double heapTime = measureHold(workload,
+            [&] { int now = heap.top(); heap.pop(); return now; },
+            [&](int deadline) { heap.push(deadline); }, heapLatency);
+
+        multiset<int> timers(workload.initial.begin(), workload.initial.end());
+        double setTime = measureHold(workload,
+            [&] { int now = *timers.begin(); timers.erase(timers.begin()); return now; },
+            [&](int deadline) { timers.insert(deadline); }, setLatency);
+
+        dast::DepthAwareSplayTree dastTree;
+        for (int deadline : workload.initial) dastTree.insert(deadline);
+        double dastTime = measureHold(workload,
+            [&] { return dastTree.pop_min(); },
+            [&](int deadline) { dastTree.insert(deadline); }, dastLatency);
+
+        // Reschedule steps: move a pending timer earlier. As in a real
+        // timer queue, each timer keeps a reference to its entry from the
+        // moment it is scheduled, so a step picks a timer without touching
+        // either structure; std::priority_queue cannot do this at all.
+        multiset<int> pendingSet;
+        dast::DepthAwareSplayTree pendingTree;
+        vector<multiset<int>::iterator> setTimers;
+        vector<dast::Node*> dastTimers;
+        for (int deadline : workload.initial) {
+            setTimers.push_back(pendingSet.insert(deadline));
+            dastTimers.push_back(pendingTree.insert(deadline));
+        }
+
+        double setRescheduleTime = 0, dastRescheduleTime = 0;
+        for (int i = 0; i < numSteps; i++) {
+            int timer = workload.probes[i] % queueSize;
+
+            auto start = high_resolution_clock::now();
+            auto handle = pendingSet.extract(setTimers[timer]);
+            handle.value() -= workload.reductions[i];
+            setTimers[timer] = pendingSet.insert(std::move(handle));
+            auto end = high_resolution_clock::now();
+            setRescheduleTime += duration_cast<duration<double>>(end - start).count();
+            setRescheduleLatency.record(end - start);
+
+            // decrease_key keeps the node, so the reference stays valid
+            dast::Node* x = dastTimers[timer];
+            start = high_resolution_clock::now();
+            pendingTree.decrease_key(x, x->key - workload.reductions[i]);
+            end = high_resolution_clock::now();
+            dastRescheduleTime += duration_cast<duration<double>>(end - start).count();
+            dastRescheduleLatency.record(end - start);
+        }
+        setRescheduleTime = setRescheduleTime / numSteps * 1e6;
+        dastRescheduleTime = dastRescheduleTime / numSteps * 1e6;
+
+        // Print results for the current queue size
+        cout << "Queue Size: " << queueSize
+             << ", priority_queue: " << heapTime << "us"
+             << ", multiset: " << setTime << "us"
+             << ", Depth-Aware Splay Tree: " << dastTime << "us"
+             << ", multiset reschedule: " << setRescheduleTime << "us"
+             << ", Depth-Aware Splay Tree reschedule: " << dastRescheduleTime << "us" << endl;
+
+        // Flag tail regressions against the std::multiset timer queue
+        regressed |= latency::compare_tail("DepthAwareSplayTree(hold)", dastLatency, "multiset(hold)", setLatency);
+        regressed |= latency::compare_tail("DepthAwareSplayTree(reschedule)", dastRescheduleLatency,
+                                           "multiset(reschedule)", setRescheduleLatency);
+
+        // Store results for CSV
+        results.push_back({(double)queueSize, heapTime, setTime, dastTime, setRescheduleTime, dastRescheduleTime});
+
+        vector<double> latencyRow = {(double)queueSize};
+        for (const auto* histogram : {&heapLatency, &setLatency, &dastLatency, &setRescheduleLatency, &dastRescheduleLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/priority_queue_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/priority_queue_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
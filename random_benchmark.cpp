@@ -1,7 +1,11 @@
 #include "bits/stdc++.h"
 #include "internal/original_splay_tree.h"
 #include "internal/depth_aware_splay_tree.h"
+#include "internal/bucket_dast.h"
+#include "internal/btree.h"
+#include "internal/memory_counter.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -39,20 +43,31 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     dast::DepthAwareSplayTree dastTree;
     ost::SplayTree tree;
+    bucket_dast::DepthAwareSplayTree<> bucketTree;
+    btree::BTree bTree;
     set<int> stdSet;
 
     // Test parameters
     int numAccess = 2000000;
-    vector<int> testSizes = {10, 100, 1000, 10000, 100000, 1000000};
+    vector<int> testSizes = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
 
     // Result storage
-    vector<vector<double>> results;
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
 
     // Column headers
-    vector<string> columns = {"TreeSize", "std::set", "OriginalSplayTree", "DepthAwareSplayTree"};
+    vector<string> columns = {"TreeSize", "std::set", "OriginalSplayTree", "DepthAwareSplayTree", "BucketDAST", "BTree",
+                              "std::set(bytes/key)", "DepthAwareSplayTree(bytes/key)", "BucketDAST(bytes/key)", "BTree(bytes/key)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"std::set", "OriginalSplayTree", "DepthAwareSplayTree", "BucketDAST", "BTree"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
 
     for (int testSize : testSizes) {
         cout << "Testing tree size: " << testSize << endl;
@@ -63,39 +78,69 @@ int main() {
         // Clear previous tree data
         dastTree.clear();
         tree.clear();
+        bucketTree.clear();
+        bTree.clear();
         stdSet.clear();
 
-        // Insert phase
-        for (const auto& q : testData) {
-            if (q.first == 0) {
-                dastTree.insert(q.second);
-                tree.insert(q.second);
-                stdSet.insert(q.second);
+        // Insert phase, one structure at a time to attribute heap usage
+        auto insertAll = [&](auto&& insert) -> double {
+            size_t before = memory::current_bytes();
+            for (const auto& q : testData) {
+                if (q.first == 0) {
+                    insert(q.second);
+                }
             }
-        }
+            return double(memory::current_bytes() - before) / testSize;
+        };
+
+        double stdSetBytes = insertAll([&](int key) { stdSet.insert(key); });
+        insertAll([&](int key) { tree.insert(key); });
+        double dastBytes = insertAll([&](int key) { dastTree.insert(key); });
+        double bucketBytes = insertAll([&](int key) { bucketTree.insert(key); });
+        double bTreeBytes = insertAll([&](int key) { bTree.insert(key); });
 
         // Measure time for each tree
-        double stdSetResult = 0, treeResult = 0, dastResult = 0;
+        double stdSetResult = 0, treeResult = 0, dastResult = 0, bucketResult = 0, bTreeResult = 0;
+        latency::Histogram stdSetLatency, treeLatency, dastLatency, bucketLatency, bTreeLatency;
+        [[maybe_unused]] const int* volatile sink = nullptr;  // Keeps side-effect free lookups from being optimized out
 
         for (const auto& q : testData) {
             if (q.first == 1) {
                 // Measure std::set
                 auto start = high_resolution_clock::now();
-                stdSet.find(q.second);
+                auto found = stdSet.find(q.second);
+                sink = found == stdSet.end() ? nullptr : &*found;
                 auto end = high_resolution_clock::now();
                 stdSetResult += duration_cast<duration<double>>(end - start).count();
+                stdSetLatency.record(end - start);
 
                 // Measure Original Splay Tree
                 start = high_resolution_clock::now();
                 tree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 treeResult += duration_cast<duration<double>>(end - start).count();
+                treeLatency.record(end - start);
 
                 // Measure Depth-Aware Splay Tree
                 start = high_resolution_clock::now();
                 dastTree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 dastResult += duration_cast<duration<double>>(end - start).count();
+                dastLatency.record(end - start);
+
+                // Measure Bucketed Depth-Aware Splay Tree
+                start = high_resolution_clock::now();
+                sink = bucketTree.lower_bound(q.second);
+                end = high_resolution_clock::now();
+                bucketResult += duration_cast<duration<double>>(end - start).count();
+                bucketLatency.record(end - start);
+
+                // Measure B-tree
+                start = high_resolution_clock::now();
+                sink = bTree.lower_bound(q.second);
+                end = high_resolution_clock::now();
+                bTreeResult += duration_cast<duration<double>>(end - start).count();
+                bTreeLatency.record(end - start);
             }
         }
 
@@ -103,19 +148,40 @@ int main() {
         double avgStdSetTime = (stdSetResult / testData.size()) * 1e6;
         double avgTreeTime = (treeResult / testData.size()) * 1e6;
         double avgDastTime = (dastResult / testData.size()) * 1e6;
+        double avgBucketTime = (bucketResult / testData.size()) * 1e6;
+        double avgBTreeTime = (bTreeResult / testData.size()) * 1e6;
 
         // Print results for the current cache pool size
         cout << "Test Size: " << testSize
              << ", std::set: " << avgStdSetTime << "us"
              << ", Original Splay Tree: " << avgTreeTime << "us"
-             << ", Depth-Aware Splay Tree: " << avgDastTime << "us" << endl;
+             << ", Depth-Aware Splay Tree: " << avgDastTime << "us"
+             << ", Bucketed DAST: " << avgBucketTime << "us"
+             << ", B-tree: " << avgBTreeTime << "us" << endl;
+        cout << "Bytes/key: std::set: " << stdSetBytes
+             << ", Depth-Aware Splay Tree: " << dastBytes
+             << ", Bucketed DAST: " << bucketBytes
+             << ", B-tree: " << bTreeBytes << endl;
+
+        // Flag tail regressions of the depth-aware tree
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "OriginalSplayTree", treeLatency);
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "std::set", stdSetLatency);
 
         // Store results for CSV
-        results.push_back({(double)testSize, avgStdSetTime, avgTreeTime, avgDastTime});
+        results.push_back({(double)testSize, avgStdSetTime, avgTreeTime, avgDastTime, avgBucketTime, avgBTreeTime,
+                           stdSetBytes, dastBytes, bucketBytes, bTreeBytes});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&stdSetLatency, &treeLatency, &dastLatency, &bucketLatency, &bTreeLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
     }
 
     // Write results to CSV
     writeCSV(results, columns, "output/random_benchmark/results_o2.csv");
+    writeCSV(latencies, latencyColumns, "output/random_benchmark/latency_o2.csv");
 
-    return 0;
+    return latency::compare_mode(argc, argv) && regressed;
 }
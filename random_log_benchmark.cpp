@@ -2,6 +2,7 @@
 #include "internal/original_splay_tree.h"
 #include "internal/depth_aware_splay_tree.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -39,7 +40,7 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     dast::DepthAwareSplayTree dastTree;
     ost::SplayTree tree;
     set<int> stdSet;
@@ -52,11 +53,19 @@ int main() {
         testSizes.push_back(i);
 
     // Result storage
-    vector<vector<double>> results;
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
 
     // Column headers
     vector<string> columns = {"TreeSize", "std::set", "OriginalSplayTree", "DepthAwareSplayTree"};
 
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"std::set", "OriginalSplayTree", "DepthAwareSplayTree"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
     for (int testSize : testSizes) {
         cout << "Testing tree size: " << testSize << endl;
 
@@ -79,6 +88,7 @@ int main() {
 
         // Measure time for each tree
         double stdSetResult = 0, treeResult = 0, dastResult = 0;
+        latency::Histogram stdSetLatency, treeLatency, dastLatency;
 
         for (const auto& q : testData) {
             if (q.first == 1) {
@@ -87,18 +97,21 @@ int main() {
                 stdSet.find(q.second);
                 auto end = high_resolution_clock::now();
                 stdSetResult += duration_cast<duration<double>>(end - start).count();
+                stdSetLatency.record(end - start);
 
                 // Measure Original Splay Tree
                 start = high_resolution_clock::now();
                 tree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 treeResult += duration_cast<duration<double>>(end - start).count();
+                treeLatency.record(end - start);
 
                 // Measure Depth-Aware Splay Tree
                 start = high_resolution_clock::now();
                 dastTree.lower_bound(q.second);
                 end = high_resolution_clock::now();
                 dastResult += duration_cast<duration<double>>(end - start).count();
+                dastLatency.record(end - start);
             }
         }
 
@@ -113,12 +126,24 @@ int main() {
              << ", Original Splay Tree: " << avgTreeTime << "us"
              << ", Depth-Aware Splay Tree: " << avgDastTime << "us" << endl;
 
+        // Flag tail regressions of the depth-aware tree
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "OriginalSplayTree", treeLatency);
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "std::set", stdSetLatency);
+
         // Store results for CSV
         results.push_back({(double)testSize, avgStdSetTime, avgTreeTime, avgDastTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&stdSetLatency, &treeLatency, &dastLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
     }
 
     // Write results to CSV
     writeCSV(results, columns, "output/random_benchmark/results_log.csv");
+    writeCSV(latencies, latencyColumns, "output/random_benchmark/latency_log.csv");
 
-    return 0;
+    return latency::compare_mode(argc, argv) && regressed;
 }
@@ -0,0 +1,153 @@
+#include "bits/stdc++.h"
+#include "internal/rcu_dast.h"
+#include "internal/sum_query_dast.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Insert keys into the tree for the given duration, with one lookup per
+// insert, and return the writer's operations per second
+template <typename Tree>
+double runWriter(Tree& tree, double seconds, mt19937& gen) {
+    long long ops = 0;
+    auto start = high_resolution_clock::now();
+    auto deadline = start + duration<double>(seconds);
+
+    while (high_resolution_clock::now() < deadline) {
+        for (int i = 0; i < 1000; i++) {
+            tree.insert(gen() >> 2);
+            tree.lower_bound(gen() >> 2);
+        }
+        ops += 2000;
+    }
+
+    auto end = high_resolution_clock::now();
+    return ops / duration_cast<duration<double>>(end - start).count();
+}
+
+int main() {
+    // Test parameters
+    int initialSize = 1000000;
+    double seconds = 2;
+    vector<int> readerCounts = {0, 1, 2, 4, 8, 16, 32};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+
+    // Column headers
+    vector<string> columns = {"Readers", "WriterOpsPerSec", "PlainWriterOpsPerSec", "AvgScanMs", "MaxScanMs", "Scans"};
+
+    // Scan latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"Readers"};
+    auto names = latency::Histogram::summary_columns("Scan");
+    latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+
+    // Writer throughput of the plain tree, which supports no readers at all
+    mt19937 plainGen(0);  // Fixed seed for reproducibility
+    sum_query_dast::DepthAwareSplayTree plainTree;
+    for (int i = 0; i < initialSize; i++) plainTree.insert(plainGen() >> 2);
+    double plainOps = runWriter(plainTree, seconds, plainGen);
+
+    for (int readers : readerCounts) {
+        cout << "Testing readers: " << readers << endl;
+
+        mt19937 gen(0);  // Fixed seed for reproducibility
+        rcu_dast::DepthAwareSplayTree tree;
+        for (int i = 0; i < initialSize; i++) tree.insert(gen() >> 2);
+
+        // Each reader repeatedly pins a snapshot and scans all of it
+        atomic<bool> stop{false};
+        vector<vector<double>> scanTimes(readers);
+        vector<latency::Histogram> scanLatency(readers);
+        vector<thread> threads;
+        for (int r = 0; r < readers; r++) {
+            threads.emplace_back([&, r] {
+                while (!stop.load()) {
+                    auto start = high_resolution_clock::now();
+                    auto snapshot = tree.snapshot();
+                    long long sum = 0;
+                    snapshot.for_each([&](int key) { sum += key; });
+                    if (sum != snapshot.range_sum(INT_MIN, INT_MAX)) {
+                        cerr << "Error: snapshot scan disagrees with range_sum" << endl;
+                        abort();
+                    }
+                    auto end = high_resolution_clock::now();
+                    scanTimes[r].push_back(duration_cast<duration<double>>(end - start).count() * 1e3);
+                    scanLatency[r].record(end - start);
+                }
+            });
+        }
+
+        double writerOps = runWriter(tree, seconds, gen);
+        stop = true;
+        for (auto& thread : threads) thread.join();
+
+        double totalScan = 0, maxScan = 0;
+        int scans = 0;
+        for (const auto& times : scanTimes) {
+            for (double time : times) {
+                totalScan += time;
+                maxScan = max(maxScan, time);
+                scans++;
+            }
+        }
+
+        vector<double> row = {(double)readers, writerOps, plainOps, scans ? totalScan / scans : 0, maxScan, (double)scans};
+
+        // Print results for the current reader count
+        cout << "Readers: " << readers;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i];
+        cout << endl;
+
+        // Store results for CSV
+        results.push_back(row);
+
+        latency::Histogram allScans;
+        for (const auto& histogram : scanLatency) allScans.merge(histogram);
+        vector<double> latencyRow = {(double)readers};
+        auto summary = allScans.summary();
+        latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/rcu_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/rcu_benchmark/latency.csv");
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "bits/stdc++.h"
+#include "internal/dast_sequence.h"
+#include "internal/latency_histogram.h"
+#include <ext/rope>
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Edit positions: an insert at the position, then an erase at the next one
+vector<int> generateEditPositions(int testSize, int numEdits, bool cursor) {
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    uniform_int_distribution<int> dist(0, testSize - 1);
+    uniform_int_distribution<int> step(-16, 16);
+    vector<int> positions;
+    int position = testSize / 2;
+
+    for (int i = 0; i < 2 * numEdits; i++) {
+        if (cursor) {
+            // A cursor drifting through the buffer, as in an editor
+            position = min(max(position + step(gen), 0), testSize - 1);
+        } else {
+            position = dist(gen);
+        }
+        positions.push_back(position);
+    }
+
+    return positions;
+}
+
+// Average time per edit in microseconds; the size stays at testSize.
+// Each edit is also recorded in histogram.
+template <typename Insert, typename Erase>
+double measureEdits(const vector<int>& positions, Insert insert, Erase erase, latency::Histogram& histogram) {
+    double total = 0;
+    for (size_t i = 0; i < positions.size(); i += 2) {
+        auto start = high_resolution_clock::now();
+        insert(positions[i], int(i));
+        auto middle = high_resolution_clock::now();
+        erase(positions[i + 1]);
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(middle - start);
+        histogram.record(end - middle);
+    }
+    return total / positions.size() * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numEdits = 100000;
+    vector<int> testSizes = {1000, 10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"SequenceSize", "std::vector(random)", "rope(random)", "DepthAwareSequence(random)",
+                              "std::vector(cursor)", "rope(cursor)", "DepthAwareSequence(cursor)"};
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"SequenceSize"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing sequence size: " << testSize << endl;
+        vector<double> row = {(double)testSize};
+
+        // One histogram per column, in column order
+        vector<latency::Histogram> histograms(columns.size() - 1);
+        int column = 0;
+
+        for (bool cursor : {false, true}) {
+            auto positions = generateEditPositions(testSize, numEdits, cursor);
+
+            vector<int> vec;
+            __gnu_cxx::rope<int> rope;
+            dast_sequence::DepthAwareSequence sequence;
+            for (int i = 0; i < testSize; i++) {
+                vec.push_back(i);
+                rope.push_back(i);
+                sequence.push_back(i);
+            }
+
+            row.push_back(measureEdits(positions,
+                [&](int position, int value) { vec.insert(vec.begin() + position, value); },
+                [&](int position) { vec.erase(vec.begin() + position); }, histograms[column++]));
+            row.push_back(measureEdits(positions,
+                [&](int position, int value) { rope.insert(position, value); },
+                [&](int position) { rope.erase(position, 1); }, histograms[column++]));
+            row.push_back(measureEdits(positions,
+                [&](int position, int value) { sequence.insert_at(position, value); },
+                [&](int position) { sequence.erase_at(position); }, histograms[column++]));
+        }
+
+        // Print results for the current sequence size
+        cout << "Sequence Size: " << testSize;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i] << "us";
+        cout << endl;
+
+        // Flag tail regressions against the rope
+        regressed |= latency::compare_tail(columns[3], histograms[2], columns[2], histograms[1]);
+        regressed |= latency::compare_tail(columns[6], histograms[5], columns[5], histograms[4]);
+
+        // Store results for CSV
+        results.push_back(row);
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto& histogram : histograms) {
+            auto summary = histogram.summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/sequence_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/sequence_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
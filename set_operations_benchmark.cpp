@@ -0,0 +1,119 @@
+#include "bits/stdc++.h"
+#include "internal/sum_query_dast.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+using Tree = sum_query_dast::DepthAwareSplayTree;
+
+// Random keys, with a fixed seed per stream for reproducibility
+vector<int> randomKeys(int count, int seed) {
+    mt19937 gen(seed);
+    vector<int> keys(count);
+    for (int& key : keys) key = gen() >> 2;
+    return keys;
+}
+
+void build(Tree& tree, const vector<int>& keys) {
+    for (int key : keys) tree.insert(key);
+}
+
+// Time one operation applied to a fresh copy of the base tree, in milliseconds
+template <typename Operation>
+double timeOperation(const vector<int>& baseKeys, const vector<int>& batchKeys, Operation operation) {
+    Tree base, batch;
+    build(base, baseKeys);
+    build(batch, batchKeys);
+
+    auto start = high_resolution_clock::now();
+    operation(base, batch);
+    auto end = high_resolution_clock::now();
+    return duration_cast<duration<double>>(end - start).count() * 1e3;
+}
+
+int main() {
+    // Test parameters
+    int baseSize = 1000000;
+    vector<double> ratios = {0.001, 0.01, 0.1, 1};
+    tasks::TaskPool pool;
+
+    // Result storage
+    vector<vector<double>> results;
+
+    // Column headers
+    vector<string> columns = {"Ratio", "RepeatedInsert", "Union", "ParallelUnion",
+                              "ParallelIntersection", "ParallelDifference", "Union(sorted)", "ParallelUnion(sorted)"};
+
+    // Trees built by inserting in key order are left as long paths, which
+    // the set operations must handle without deep recursion
+    auto baseKeys = randomKeys(baseSize, 0);
+    auto sortedBaseKeys = baseKeys;
+    sort(sortedBaseKeys.begin(), sortedBaseKeys.end());
+    cout << "Base size: " << baseSize << ", pool threads: " << pool.size() << endl;
+
+    for (double ratio : ratios) {
+        int batchSize = baseSize * ratio;
+        cout << "Testing batch size: " << batchSize << endl;
+        auto batchKeys = randomKeys(batchSize, 1);
+        auto sortedBatchKeys = batchKeys;
+        sort(sortedBatchKeys.begin(), sortedBatchKeys.end());
+
+        vector<double> row = {ratio};
+        row.push_back(timeOperation(baseKeys, batchKeys, [&](Tree& base, Tree&) {
+            for (int key : batchKeys) base.insert(key);
+        }));
+        row.push_back(timeOperation(baseKeys, batchKeys, [&](Tree& base, Tree& batch) { base.union_with(batch); }));
+        row.push_back(timeOperation(baseKeys, batchKeys, [&](Tree& base, Tree& batch) { base.union_with(batch, &pool); }));
+        row.push_back(timeOperation(baseKeys, batchKeys, [&](Tree& base, Tree& batch) { base.intersect_with(batch, &pool); }));
+        row.push_back(timeOperation(baseKeys, batchKeys, [&](Tree& base, Tree& batch) { base.difference_with(batch, &pool); }));
+        row.push_back(timeOperation(sortedBaseKeys, sortedBatchKeys, [&](Tree& base, Tree& batch) { base.union_with(batch); }));
+        row.push_back(timeOperation(sortedBaseKeys, sortedBatchKeys, [&](Tree& base, Tree& batch) { base.union_with(batch, &pool); }));
+
+        // Print results for the current ratio
+        cout << "Ratio: " << ratio;
+        for (size_t i = 1; i < row.size(); i++)
+            cout << ", " << columns[i] << ": " << row[i] << "ms";
+        cout << endl;
+
+        // Store results for CSV
+        results.push_back(row);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/set_operations_benchmark/results.csv");
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "bits/stdc++.h"
+#include "internal/simd_search.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Average nanoseconds per in-node search. The nodes are small enough to stay
+// in cache, so this isolates the kernel cost from the descent's cache misses.
+template <typename Search>
+double measureKernel(const vector<int>& keys, const vector<pair<int, int>>& queries, int nodeSize, Search search) {
+    long long checksum = 0;
+
+    auto start = high_resolution_clock::now();
+    for (const auto& q : queries) {
+        checksum += search(keys.data() + q.first * nodeSize, nodeSize, q.second);
+    }
+    auto end = high_resolution_clock::now();
+
+    if (checksum < 0) cout << checksum << endl;  // Keeps the searches observable
+    return duration_cast<duration<double>>(end - start).count() / queries.size() * 1e9;
+}
+
+int main() {
+    // Test parameters
+    int numNodes = 1024;
+    int numQueries = 20000000;
+    vector<int> nodeSizes = {4, 8, 12, 16, 24, 32, 48, 64};
+
+    // Result storage
+    vector<vector<double>> results;
+
+    // Column headers
+    vector<string> columns = {"NodeSize", "std::lower_bound", "Scalar", "SSE", "AVX2"};
+
+    mt19937 gen(0);  // Fixed seed for reproducibility
+
+    bool hasSse = simd::has_sse();
+    bool hasAvx2 = simd::has_avx2();
+
+    for (int nodeSize : nodeSizes) {
+        cout << "Testing node size: " << nodeSize << endl;
+
+        // Generate sorted nodes and queries against them
+        vector<int> keys(numNodes * nodeSize);
+        uniform_int_distribution<int> keyDist(0, 1 << 30);
+        for (int& key : keys) key = keyDist(gen);
+        for (int i = 0; i < numNodes; i++)
+            sort(keys.begin() + i * nodeSize, keys.begin() + (i + 1) * nodeSize);
+
+        vector<pair<int, int>> queries(numQueries);
+        uniform_int_distribution<int> nodeDist(0, numNodes - 1);
+        for (auto& q : queries) q = {nodeDist(gen), keyDist(gen)};
+
+        double stdTime = measureKernel(keys, queries, nodeSize, [](const int* k, int n, int key) {
+            return int(lower_bound(k, k + n, key) - k);
+        });
+        double scalarTime = measureKernel(keys, queries, nodeSize, simd::count_less_scalar);
+        double sseTime = 0, avx2Time = 0;
+#if SIMD_SEARCH_X86
+        if (hasSse) sseTime = measureKernel(keys, queries, nodeSize, simd::count_less_sse);
+        if (hasAvx2) avx2Time = measureKernel(keys, queries, nodeSize, simd::count_less_avx2);
+#endif
+
+        // Print results for the current node size
+        cout << "Node Size: " << nodeSize
+             << ", std::lower_bound: " << stdTime << "ns"
+             << ", Scalar: " << scalarTime << "ns"
+             << ", SSE: " << (hasSse ? to_string(sseTime) + "ns" : "unsupported")
+             << ", AVX2: " << (hasAvx2 ? to_string(avx2Time) + "ns" : "unsupported") << endl;
+
+        // Store results for CSV
+        results.push_back({(double)nodeSize, stdTime, scalarTime, sseTime, avx2Time});
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/simd_benchmark/results.csv");
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "bits/stdc++.h"
+#include "internal/string_dast.h"
+#include "internal/latency_histogram.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// URL-like keys: a few schemes and hosts, then nested path segments, so
+// that neighbouring keys share long prefixes
+vector<string> generateUrlKeys(int count) {
+    vector<string> keys;
+    mt19937 gen(0);  // Fixed seed for reproducibility
+    const char* sections[] = {"products", "users", "static/images", "api/v2/orders", "blog/posts"};
+
+    for (int i = 0; i < count; i++) {
+        string key = (gen() % 4 ? "https://www." : "http://cdn.") + string("shop") + to_string(gen() % 50) + ".example.com/";
+        key += sections[gen() % 5];
+        key += "/" + to_string(gen() % 1000) + "/item-" + to_string(gen() % 100000);
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+// Filesystem-like keys under a handful of deep, shared directories
+vector<string> generatePathKeys(int count) {
+    vector<string> keys;
+    mt19937 gen(1);  // Fixed seed for reproducibility
+
+    for (int i = 0; i < count; i++) {
+        string key = "/home/build/workspace/project" + to_string(gen() % 20) + "/src/module" + to_string(gen() % 200);
+        key += "/internal/detail/file_" + to_string(gen() % 1000000) + ".cpp";
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+// Insert all keys, then time lookups of existing keys in random order;
+// returns the average lookup time in microseconds and records each lookup
+// in histogram
+template <typename Insert, typename Lookup>
+double measure(const vector<string>& keys, const vector<int>& order, Insert insert, Lookup lookup,
+               latency::Histogram& histogram) {
+    for (const auto& key : keys) insert(key);
+
+    double total = 0;
+    size_t found = 0;
+    for (int i : order) {
+        auto start = high_resolution_clock::now();
+        found += lookup(keys[i]);
+        auto end = high_resolution_clock::now();
+        total += duration_cast<duration<double>>(end - start).count();
+        histogram.record(end - start);
+    }
+
+    if (found != order.size()) cerr << "Error: lookups missed " << order.size() - found << " keys" << endl;
+    return total / order.size() * 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    // Test parameters
+    int numAccess = 1000000;
+    vector<int> testSizes = {10000, 100000, 1000000};
+
+    // Result storage
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
+
+    // Column headers
+    vector<string> columns = {"TreeSize"};
+    for (string keySet : {"url", "path"})
+        for (string name : {"std::set<string>", "StringDAST", "StringDAST(no prefix cache)", "StringDAST(plain compare)"})
+            columns.push_back(name + "(" + keySet + ")");
+
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (size_t i = 1; i < columns.size(); i++) {
+        auto names = latency::Histogram::summary_columns(columns[i]);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
+    for (int testSize : testSizes) {
+        cout << "Testing tree size: " << testSize << endl;
+        vector<double> row = {(double)testSize};
+
+        // One histogram per column, in column order
+        vector<latency::Histogram> histograms(columns.size() - 1);
+        int column = 0;
+
+        for (auto keys : {generateUrlKeys(testSize), generatePathKeys(testSize)}) {
+            mt19937 gen(2);
+            vector<int> order(numAccess);
+            for (int& i : order) i = gen() % keys.size();
+
+            set<string> stdSet;
+            double setTime = measure(keys, order, [&](const string& key) { stdSet.insert(key); },
+                                     [&](const string& key) { return stdSet.lower_bound(key) != stdSet.end(); },
+                                     histograms[column]);
+
+            // Both shortcuts, then the inline prefix alone turned off, then both
+            double dastTimes[3];
+            for (int variant = 0; variant < 3; variant++) {
+                string_dast::DepthAwareSplayTree dastTree;
+                dastTree.prefix_cache = variant == 0;
+                dastTree.skip_common_prefix = variant < 2;
+                dastTimes[variant] = measure(keys, order, [&](const string& key) { dastTree.insert(key); },
+                                             [&](const string& key) { return dastTree.lower_bound(key) != nullptr; },
+                                             histograms[column + 1 + variant]);
+            }
+
+            cout << "std::set<string>: " << setTime << "us"
+                 << ", String DAST: " << dastTimes[0] << "us"
+                 << ", no prefix cache: " << dastTimes[1] << "us"
+                 << ", plain compare: " << dastTimes[2] << "us" << endl;
+            row.insert(row.end(), {setTime, dastTimes[0], dastTimes[1], dastTimes[2]});
+
+            // Flag a tail regression against std::set<string>
+            regressed |= latency::compare_tail(columns[column + 2], histograms[column + 1], columns[column + 1], histograms[column]);
+            column += 4;
+        }
+
+        // Store results for CSV
+        results.push_back(row);
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto& histogram : histograms) {
+            auto summary = histogram.summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
+    }
+
+    // Write results to CSV
+    writeCSV(results, columns, "output/string_benchmark/results.csv");
+    writeCSV(latencies, latencyColumns, "output/string_benchmark/latency.csv");
+
+    return latency::compare_mode(argc, argv) && regressed;
+}
@@ -3,6 +3,7 @@
 #include "internal/depth_aware_splay_tree.h"
 #include "internal/sum_query_dast.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -40,7 +41,7 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     sum_query_dast::DepthAwareSplayTree dastTree;
     ost::SplayTree tree;
     set<int> stdSet;
@@ -53,11 +54,19 @@ int main() {
         testSizes.push_back(i);
 
     // Result storage
-    vector<vector<double>> results;
+    vector<vector<double>> results, latencies;
+    bool regressed = false;
 
     // Column headers
     vector<string> columns = {"TreeSize", "std::set", "DepthAwareSplayTree"};
 
+    // Latency percentile columns (microseconds)
+    vector<string> latencyColumns = {"TreeSize"};
+    for (const char* name : {"std::set", "DepthAwareSplayTree"}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+    }
+
     random_device rd;  // Seed generator
     mt19937 gen(rd()); // Mersenne Twister PRNG
 
@@ -84,6 +93,7 @@ int main() {
 
         // Measure time for each tree
         double stdSetResult = 0, treeResult = 0, dastResult = 0;
+        latency::Histogram stdSetLatency, dastLatency;
         auto set_sum = [&](int nl, int nr) -> long long {
             long long sum = 0;
 
@@ -118,12 +128,14 @@ int main() {
             set_sum(n1, n2);
             auto end = high_resolution_clock::now();
             stdSetResult += duration_cast<duration<double>>(end - start).count();
+            stdSetLatency.record(end - start);
 
             // Measure Depth-Aware Splay Tree
             start = high_resolution_clock::now();
             dast_sum(n1, n2);
             end = high_resolution_clock::now();
             dastResult += duration_cast<duration<double>>(end - start).count();
+            dastLatency.record(end - start);
         }
 
         // Average times (convert to microseconds)
@@ -135,12 +147,23 @@ int main() {
              << ", std::set: " << avgStdSetTime << "us"
              << ", Depth-Aware Splay Tree: " << avgDastTime << "us" << endl;
 
+        // Flag tail regressions of the depth-aware tree
+        regressed |= latency::compare_tail("DepthAwareSplayTree", dastLatency, "std::set", stdSetLatency);
+
         // Store results for CSV
         results.push_back({(double)testSize, avgStdSetTime, avgDastTime});
+
+        vector<double> latencyRow = {(double)testSize};
+        for (const auto* histogram : {&stdSetLatency, &dastLatency}) {
+            auto summary = histogram->summary();
+            latencyRow.insert(latencyRow.end(), summary.begin(), summary.end());
+        }
+        latencies.push_back(latencyRow);
     }
 
     // Write results to CSV
     writeCSV(results, columns, "output/range_sum_benchmark/results_log.csv");
+    writeCSV(latencies, latencyColumns, "output/range_sum_benchmark/latency_log.csv");
 
-    return 0;
+    return latency::compare_mode(argc, argv) && regressed;
 }
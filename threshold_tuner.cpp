@@ -0,0 +1,219 @@
+#include "bits/stdc++.h"
+#include "internal/depth_aware_splay_tree.h"
+#include "internal/test_gen.h"
+
+using namespace std;
+using namespace chrono;
+
+// Function to write data to CSV
+void writeCSV(const vector<vector<double>>& data, const vector<string>& columns, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return;
+    }
+    file << fixed << setprecision(6);  // Set precision for float/double values
+
+    // Write column headers
+    for (size_t i = 0; i < columns.size(); ++i) {
+        file << columns[i];
+        if (i < columns.size() - 1) {
+            file << ",";
+        }
+    }
+    file << "\n";
+
+    // Write data rows
+    for (const auto& row : data) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            file << row[i];  // Write the value as milliseconds
+            if (i < row.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    cout << "Data has been written to " << filename << endl;
+}
+
+// Sweeps the fixed splay depth threshold over a recorded operation trace,
+// one independent tree per worker thread, and recommends the coefficient c
+// of the threshold formula c * log2(size) that minimizes the chosen cost.
+//
+// Usage: threshold_tuner [--trace FILE] [--record FILE] [--output FILE]
+//                        [--threads N] [--max-threshold T] [--metric time|model]
+//
+// Without --trace the gradual access test from adversarial_dast_analysis is
+// replayed; --record writes the replayed trace out in the same format. Trace
+// operations are 0 (insert), 3 (remove) and anything else (lower_bound).
+
+// Fixed-threshold splay policy that also records the cost of the replay:
+// nodes visited by every access and by every splay
+struct SweepPolicy {
+    int threshold = 0;
+    long long total_depth = 0;
+    long long splay_depth = 0;
+    long long splay_count = 0;
+
+    void resize(int) {}
+
+    template <typename Node>
+    bool should_splay(int depth, Node *) {
+        total_depth += depth;
+        if (depth < threshold)
+            return false;
+        splay_count++;
+        splay_depth += depth;
+        return true;
+    }
+};
+
+struct SweepResult {
+    double time = 0;       // Average time per operation (microseconds)
+    double avg_depth = 0;  // Average nodes visited per access
+    double model_cost = 0; // Average nodes visited plus nodes splayed
+    long long splay_count = 0;
+};
+
+// Replay the whole trace against a fresh tree with the given threshold
+SweepResult replay(const test::TestType& trace, int threshold) {
+    dast::BasicDepthAwareSplayTree<SweepPolicy> tree;
+    tree.policy.threshold = threshold;
+
+    auto start = high_resolution_clock::now();
+    for (const auto& q : trace) {
+        if (q.first == 0) {
+            tree.insert(q.second);
+        } else if (q.first == 3) {
+            dast::Node* x = tree.lower_bound(q.second);
+            if (x && x->key == q.second) tree.remove(x);
+        } else {
+            tree.lower_bound(q.second);
+        }
+    }
+    auto end = high_resolution_clock::now();
+
+    SweepResult result;
+    result.time = duration_cast<duration<double>>(end - start).count() / trace.size() * 1e6;
+    result.avg_depth = double(tree.policy.total_depth) / trace.size();
+    result.model_cost = double(tree.policy.total_depth + tree.policy.splay_depth) / trace.size();
+    result.splay_count = tree.policy.splay_count;
+    return result;
+}
+
+// Largest number of keys live at any point of the trace
+int peakSize(const test::TestType& trace) {
+    unordered_set<int> keys;
+    size_t peak = 0;
+    for (const auto& q : trace) {
+        if (q.first == 0) keys.insert(q.second);
+        else if (q.first == 3) keys.erase(q.second);
+        peak = max(peak, keys.size());
+    }
+    return peak;
+}
+
+int main(int argc, char* argv[]) {
+    string tracePath, recordPath, outputPath = "output/threshold_tuner/cost_curve.csv", metric = "time";
+    int numThreads = max(1u, thread::hardware_concurrency());
+    int maxThreshold = -1;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--trace") tracePath = value;
+        else if (arg == "--record") recordPath = value;
+        else if (arg == "--output") outputPath = value;
+        else if (arg == "--threads") numThreads = max(1, stoi(value));
+        else if (arg == "--max-threshold") maxThreshold = stoi(value);
+        else if (arg == "--metric") metric = value;
+        else {
+            cerr << "Error: Unknown option " << arg << endl;
+            return 1;
+        }
+    }
+
+    if (metric != "time" && metric != "model") {
+        cerr << "Error: --metric must be time or model" << endl;
+        return 1;
+    }
+
+    // Load or generate the trace
+    test::TestType trace;
+    if (tracePath.empty()) {
+        trace = test::generateGradualAccessTest(10000, 10);
+    } else if (!test::readTrace(tracePath, trace)) {
+        cerr << "Error: Unable to read trace " << tracePath << endl;
+        return 1;
+    }
+
+    if (!recordPath.empty() && !test::writeTrace(trace, recordPath)) {
+        cerr << "Error: Unable to write trace " << recordPath << endl;
+        return 1;
+    }
+
+    if (trace.empty()) {
+        cerr << "Error: Empty trace" << endl;
+        return 1;
+    }
+
+    int size = peakSize(trace);
+    double logSize = log2(max(size, 2));
+    if (maxThreshold < 0) maxThreshold = ceil(4 * logSize);
+    int numThresholds = maxThreshold + 1;
+    numThreads = min(numThreads, numThresholds);
+
+    cout << "Trace: " << trace.size() << " operations, peak size " << size
+         << ", thresholds 0-" << maxThreshold << ", " << numThreads << " threads" << endl;
+
+    // Workers claim thresholds one at a time; each replays on its own tree
+    vector<SweepResult> results(numThresholds);
+    atomic<int> nextThreshold{0};
+    vector<thread> workers;
+
+    for (int w = 0; w < numThreads; w++) {
+        workers.emplace_back([&] {
+            for (int t; (t = nextThreshold++) < numThresholds;)
+                results[t] = replay(trace, t);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    // Timings are noisy, so the time metric is smoothed over neighbouring
+    // thresholds before taking the minimum; the model cost is exact
+    vector<double> cost(numThresholds);
+    for (int t = 0; t < numThresholds; t++) {
+        if (metric == "model") {
+            cost[t] = results[t].model_cost;
+            continue;
+        }
+        int lo = max(0, t - 2), hi = min(numThresholds - 1, t + 2);
+        for (int u = lo; u <= hi; u++) cost[t] += results[u].time;
+        cost[t] /= hi - lo + 1;
+    }
+
+    int best = min_element(cost.begin(), cost.end()) - cost.begin();
+
+    vector<vector<double>> rows;
+    for (int t = 0; t < numThresholds; t++) {
+        rows.push_back({(double)t, t / logSize, results[t].time, results[t].avg_depth,
+                        (double)results[t].splay_count, results[t].model_cost});
+    }
+
+    vector<string> columns = {"depth_threshold", "coefficient", "avg_op_time(microseconds)",
+                              "avg_depth", "splay_count", "model_cost"};
+    writeCSV(rows, columns, outputPath);
+
+    cout << "Recommended threshold: " << best << " (" << metric << " cost " << cost[best] << ")" << endl;
+    cout << "Recommended coefficient: " << fixed << setprecision(3) << best / logSize
+         << " (threshold = coefficient * log2(size))" << endl;
+
+    return 0;
+}
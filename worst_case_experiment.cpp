@@ -2,6 +2,7 @@
 #include "internal/original_splay_tree.h"
 #include "internal/depth_aware_splay_tree.h"
 #include "internal/test_gen.h"
+#include "internal/latency_histogram.h"
 
 using namespace std;
 using namespace chrono;
@@ -39,7 +40,7 @@ void writeCSV(const vector<vector<double>>& data, const vector<string>& columns,
     cout << "Data has been written to " << filename << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     dast::DepthAwareSplayTree dastTree;
     ost::SplayTree tree;
 
@@ -50,6 +51,7 @@ int main() {
     auto testData = test::generateGradualAccessTest(testSize, cycle);
 
     vector<vector<double>> normalSplayTimes;
+    latency::Histogram normalSplayLatency, fastSplayLatency;
     // Benchmark fast splay tree
     for (auto q : testData) {
         if (q.first == 0) {
@@ -60,6 +62,7 @@ int main() {
             auto end = high_resolution_clock::now();
             double queryTime = duration_cast<duration<double>>(end - start).count();
             normalSplayTimes.push_back({queryTime});
+            normalSplayLatency.record(end - start);
         }
     }
 
@@ -75,6 +78,7 @@ int main() {
             auto end = high_resolution_clock::now();
             double queryTime = duration_cast<duration<double>>(end - start).count();
             fastSplayTimes.push_back({queryTime});
+            fastSplayLatency.record(end - start);
         }
     }
 
@@ -82,5 +86,16 @@ int main() {
     writeCSV(normalSplayTimes, {"query_time"}, "output/worst_case_experiment/splay_tree.csv");
     writeCSV(fastSplayTimes, {"query_time"}, "output/worst_case_experiment/dast_tree.csv");
 
-    return 0;
+    // Percentile summary; writeCSV scales by 1000, so seconds become milliseconds
+    vector<string> latencyColumns;
+    vector<double> latencyRow;
+    for (auto [name, histogram] : {pair{"SplayTree", &normalSplayLatency}, pair{"DepthAwareSplayTree", &fastSplayLatency}}) {
+        auto names = latency::Histogram::summary_columns(name);
+        latencyColumns.insert(latencyColumns.end(), names.begin(), names.end());
+        for (double microseconds : histogram->summary()) latencyRow.push_back(microseconds / 1e6);
+    }
+    writeCSV({latencyRow}, latencyColumns, "output/worst_case_experiment/latency.csv");
+
+    bool regressed = latency::compare_tail("DepthAwareSplayTree", fastSplayLatency, "SplayTree", normalSplayLatency);
+    return latency::compare_mode(argc, argv) && regressed;
 }